@@ -0,0 +1,103 @@
+// Latência de ida e volta do protocolo de controle UDP contra a placa
+// Uso: controle_udp_rtt [-n envios] [-f hz] [-p porta] [-t timeout_ms] host [comando...]
+//
+// Envia n datagramas com os comandos dados (padrão: "estado") e mede o tempo até o ack
+// de cada um, sem retransmitir. Comandos: estado, comodo:N, cor:N, ligar:0|1,
+// alarme_off, cena:COMODO:COR:LIGADO (vários comandos vão no mesmo datagrama).
+// Saída no formato chave=valor, como o summary.txt do simulador.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "controle_udp_cliente.h"
+
+static uint64_t agora_us(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000u + t.tv_nsec / 1000;
+}
+
+static int comparar(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void uso(const char *prog) {
+  fprintf(stderr, "uso: %s [-n envios] [-f hz] [-p porta] [-t timeout_ms] host [comando...]\n", prog);
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  int envios = 1000, timeout_ms = 500, porta = CONTROLE_UDP_PORTA;
+  double hz = 0;                       // 0 = envia o próximo assim que o ack chega
+  int opt;
+  while ((opt = getopt(argc, argv, "n:f:p:t:")) != -1) {
+    switch (opt) {
+      case 'n': envios = atoi(optarg); break;
+      case 'f': hz = atof(optarg); break;
+      case 'p': porta = atoi(optarg); break;
+      case 't': timeout_ms = atoi(optarg); break;
+      default: uso(argv[0]);
+    }
+  }
+  if (optind >= argc || envios <= 0)
+    uso(argv[0]);
+
+  controle_cmd_t cmds[CONTROLE_UDP_MAX_CMDS] = {{CONTROLE_CMD_ESTADO, 0, 0, 0}};
+  uint8_t n = 1;
+  if (optind + 1 < argc) {
+    n = 0;
+    for (int i = optind + 1; i < argc && n < CONTROLE_UDP_MAX_CMDS; ++i) {
+      if (!controle_cliente_ler_comando(argv[i], &cmds[n++])) {
+        fprintf(stderr, "comando inválido: %s\n", argv[i]);
+        return 2;
+      }
+    }
+  }
+
+  controle_cliente_t cliente;
+  if (!controle_cliente_abrir(&cliente, argv[optind], (uint16_t)porta)) {
+    fprintf(stderr, "não foi possível abrir %s:%d\n", argv[optind], porta);
+    return 1;
+  }
+
+  uint64_t *rtt = malloc(envios * sizeof(uint64_t));
+  int recebidos = 0, rejeitados = 0;
+  uint64_t inicio = agora_us();
+  for (int i = 0; i < envios; ++i) {
+    if (hz > 0) {                      // ritmo fixo: espera o instante do próximo envio
+      uint64_t alvo = inicio + (uint64_t)(i * 1e6 / hz);
+      uint64_t t = agora_us();
+      if (t < alvo)
+        usleep(alvo - t);
+    }
+    controle_ack_t ack;
+    uint64_t t0 = agora_us();
+    if (controle_cliente_enviar(&cliente, cmds, n, &ack, timeout_ms, 1) > 0) {
+      rtt[recebidos++] = agora_us() - t0;
+      if (ack.status != CONTROLE_OK)
+        rejeitados++;
+    }
+  }
+  double duracao_s = (agora_us() - inicio) / 1e6;
+  controle_cliente_fechar(&cliente);
+
+  qsort(rtt, recebidos, sizeof(uint64_t), comparar);
+  printf("sent=%d\n", envios);
+  printf("acked=%d\n", recebidos);
+  printf("lost=%d\n", envios - recebidos);
+  printf("not_applied=%d\n", rejeitados);
+  printf("commands_per_datagram=%u\n", n);
+  printf("datagram_bytes=%u\n", CONTROLE_UDP_CABECALHO + 4 * n);
+  printf("updates_per_s=%.1f\n", duracao_s > 0 ? recebidos / duracao_s : 0.0);
+  if (recebidos) {
+    printf("rtt_min_us=%llu\n", (unsigned long long)rtt[0]);
+    printf("rtt_p50_us=%llu\n", (unsigned long long)rtt[recebidos / 2]);
+    printf("rtt_p90_us=%llu\n", (unsigned long long)rtt[recebidos * 9 / 10]);
+    printf("rtt_p99_us=%llu\n", (unsigned long long)rtt[recebidos * 99 / 100]);
+    printf("rtt_max_us=%llu\n", (unsigned long long)rtt[recebidos - 1]);
+  }
+  free(rtt);
+  return recebidos ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// Microbenchmarks da biblioteca SSD1306 (lib/ssd1306.c) no host
+// Uso: ssd1306_bench [-t ms_por_amostra] [-r repeticoes] [filtro]
+//
+// Saída em CSV, uma linha por primitiva, com nomes estáveis para comparar commits:
+//   benchmark,iterations,ns_per_call,i2c_bytes_per_call,i2c_transactions_per_call
+// Os bytes de I2C incluem o byte de endereço de cada transação.
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ssd1306.h"
+#include "ssd1306_espelho.h"
+#include "temperatura.h"
+
+typedef struct {
+  const char *nome;
+  void (*fn)(void);
+} bench_t;
+
+i2c_inst_t sim_i2c_inst[2] = {{0, 400000}, {1, 400000}};
+
+static ssd1306_t ssd;
+static uint64_t i2c_bytes = 0;
+static uint64_t i2c_transacoes = 0;
+static volatile uint8_t sumidouro;     // impede que o compilador descarte o buffer
+
+// stub do barramento: apenas conta o tráfego
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)i2c;
+  (void)addr;
+  (void)nostop;
+  i2c_bytes += len + 1;
+  i2c_transacoes++;
+  sumidouro = src[len - 1];
+  return (int)len;
+}
+
+static void b_fill_0(void) { ssd1306_fill(&ssd, false); }
+static void b_fill_1(void) { ssd1306_fill(&ssd, true); }
+static void b_pixel(void) { ssd1306_pixel(&ssd, 64, 32, true); }
+static void b_rect(void) { ssd1306_rect(&ssd, 3, 3, 122, 58, true, false); }
+static void b_rect_fill(void) { ssd1306_rect(&ssd, 3, 3, 122, 58, true, true); }
+static void b_hline(void) { ssd1306_hline(&ssd, 0, 127, 32, true); }
+static void b_vline(void) { ssd1306_vline(&ssd, 64, 0, 63, true); }
+static void b_line_diag(void) { ssd1306_line(&ssd, 0, 0, 127, 63, true); }
+static void b_draw_char(void) { ssd1306_draw_char(&ssd, 'A', 20, 18); }
+static void b_draw_string(void) { ssd1306_draw_string(&ssd, "EMERGENCIA: OFF", 2, 34); }
+// dígitos grandes: 3x proporcional (glifos vindos do cache), 2x de largura fixa e a fonte 12x16
+static void b_draw_big(void) { ssd1306_draw_string_font(&ssd, &ssd1306_font_8x8_prop, 3, "27.3C", 11, 10); }
+static void b_draw_12x16(void) { ssd1306_draw_string_font(&ssd, &ssd1306_font_12x16_digitos, 1, "27.3", 38, 14); }
+static void b_draw_2x(void) { ssd1306_draw_string_font(&ssd, &ssd1306_font_8x8, 2, "27.3C", 0, 10); }
+static void b_send_data(void) { ssd1306_send_data(&ssd); }
+static void b_config(void) { ssd1306_config(&ssd); }
+
+// mesma sequência de atualizar_display() em main.c
+static void b_status_screen(void) {
+  ssd1306_fill(&ssd, false);
+  ssd1306_draw_string(&ssd, "QUARTO 1", 20, 0);
+  uint8_t largura = ssd1306_string_width(&ssd1306_font_12x16_digitos, 1, "27.3") +
+                    ssd1306_string_width(&ssd1306_font_8x8_prop, 1, "C");
+  uint8_t x = ssd1306_draw_string_font(&ssd, &ssd1306_font_12x16_digitos, 1, "27.3", (WIDTH - largura) / 2, 14);
+  ssd1306_draw_string_font(&ssd, &ssd1306_font_8x8_prop, 1, "C", x, 15);
+  ssd1306_draw_string(&ssd, "EMERGENCIA: OFF", 2, 38);
+  ssd1306_draw_string(&ssd, "192.168.0.106", 6, 54);
+  ssd1306_send_data(&ssd);
+}
+
+// espelho do OLED: quadro completo e delta de uma tela de status com um pixel alterado
+static uint8_t espelho_saida[ESPELHO_MAX_SAIDA];
+static uint32_t espelho_versao;
+
+static void b_espelho_full(void) {
+  espelho_quadro_t info;
+  ssd1306_espelho_codificar(&ssd, 0, espelho_saida, sizeof(espelho_saida), &info);
+}
+
+static void b_espelho_delta(void) {
+  espelho_quadro_t info;
+  static bool aceso;
+  ssd1306_pixel(&ssd, 100, 60, aceso = !aceso);
+  ssd1306_espelho_codificar(&ssd, espelho_versao, espelho_saida, sizeof(espelho_saida), &info);
+  espelho_versao = info.versao;
+}
+
+// temperatura do OLED e da página: fórmula em float + "%.1f" (versão antiga) e ponto fixo
+static volatile uint16_t adc_bruto = 876;     // ~27°C; volatile para não virar constante
+static char temperatura_texto[16];
+
+static void b_temp_float(void) {
+  const float fator_conversao = 3.3f / (1 << 12);
+  float temperatura = 27.0f - ((adc_bruto * fator_conversao) - 0.706f) / 0.001721f;
+  snprintf(temperatura_texto, sizeof(temperatura_texto), "%.1fC", temperatura);
+}
+
+static void b_temp_fixo(void) {
+  uint8_t n = temperatura_formatar(temperatura_centi(adc_bruto), temperatura_texto);
+  temperatura_texto[n++] = 'C';
+  temperatura_texto[n] = '\0';
+}
+
+static const bench_t benches[] = {
+  {"fill_0", b_fill_0},
+  {"fill_1", b_fill_1},
+  {"pixel", b_pixel},
+  {"rect", b_rect},
+  {"rect_fill", b_rect_fill},
+  {"hline", b_hline},
+  {"vline", b_vline},
+  {"line_diag", b_line_diag},
+  {"draw_char", b_draw_char},
+  {"draw_string", b_draw_string},
+  {"draw_big", b_draw_big},
+  {"draw_2x", b_draw_2x},
+  {"draw_12x16", b_draw_12x16},
+  {"send_data", b_send_data},
+  {"config", b_config},
+  {"status_screen", b_status_screen},
+  {"espelho_full", b_espelho_full},
+  {"espelho_delta", b_espelho_delta},
+  {"temp_float", b_temp_float},
+  {"temp_fixo", b_temp_fixo},
+};
+
+static uint64_t agora_ns(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000u + t.tv_nsec;
+}
+
+static uint64_t executar(const bench_t *b, uint64_t n) {
+  uint64_t t0 = agora_ns();
+  for (uint64_t i = 0; i < n; ++i)
+    b->fn();
+  return agora_ns() - t0;
+}
+
+int main(int argc, char **argv) {
+  uint64_t amostra_ns = 100 * 1000000ull;
+  int repeticoes = 5;
+  int opt;
+  while ((opt = getopt(argc, argv, "t:r:")) != -1) {
+    switch (opt) {
+      case 't': amostra_ns = strtoull(optarg, NULL, 10) * 1000000ull; break;
+      case 'r': repeticoes = atoi(optarg); break;
+      default:
+        fprintf(stderr, "uso: %s [-t ms_por_amostra] [-r repeticoes] [filtro]\n", argv[0]);
+        return 2;
+    }
+  }
+  const char *filtro = optind < argc ? argv[optind] : NULL;
+
+  if (!ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1))
+    return 1;
+  printf("benchmark,iterations,ns_per_call,i2c_bytes_per_call,i2c_transactions_per_call\n");
+  for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i) {
+    const bench_t *b = &benches[i];
+    if (filtro && !strstr(b->nome, filtro))
+      continue;
+
+    // tráfego de uma única chamada (determinístico)
+    i2c_bytes = i2c_transacoes = 0;
+    b->fn();
+    uint64_t bytes = i2c_bytes, transacoes = i2c_transacoes;
+
+    // calibra o número de iterações para ~amostra_ns e fica com a melhor amostra
+    uint64_t n = 1;
+    while (executar(b, n) < amostra_ns / 10 && n < (1ull << 40))
+      n *= 2;
+    n = n * 10;
+    double melhor = 1e300;
+    for (int r = 0; r < repeticoes; ++r) {
+      double ns = (double)executar(b, n) / n;
+      if (ns < melhor)
+        melhor = ns;
+    }
+    printf("%s,%llu,%.1f,%llu,%llu\n", b->nome, (unsigned long long)n, melhor,
+           (unsigned long long)bytes, (unsigned long long)transacoes);
+  }
+  return 0;
+}
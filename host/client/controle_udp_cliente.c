@@ -0,0 +1,96 @@
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "controle_udp_cliente.h"
+
+bool controle_cliente_abrir(controle_cliente_t *c, const char *host, uint16_t porta) {
+  struct addrinfo dicas = {.ai_family = AF_INET, .ai_socktype = SOCK_DGRAM}, *res;
+  if (getaddrinfo(host, NULL, &dicas, &res))
+    return false;
+  c->destino = *(struct sockaddr_in *)res->ai_addr;
+  c->destino.sin_port = htons(porta);
+  freeaddrinfo(res);
+
+  c->fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (c->fd < 0)
+    return false;
+  // só aceita datagramas do painel
+  if (connect(c->fd, (struct sockaddr *)&c->destino, sizeof(c->destino))) {
+    close(c->fd);
+    return false;
+  }
+  // seq inicial aleatório: um cliente reiniciado não colide com o seq lembrado pelo painel
+  struct timespec t;
+  clock_gettime(CLOCK_REALTIME, &t);
+  c->seq = (uint32_t)(t.tv_nsec ^ (t.tv_sec << 20) ^ getpid());
+  return true;
+}
+
+void controle_cliente_fechar(controle_cliente_t *c) {
+  if (c->fd >= 0)
+    close(c->fd);
+  c->fd = -1;
+}
+
+int controle_cliente_enviar(controle_cliente_t *c, const controle_cmd_t *cmds, uint8_t n,
+                            controle_ack_t *ack, int timeout_ms, int tentativas) {
+  uint8_t datagrama[CONTROLE_UDP_MAX_DATAGRAMA], resposta[64];
+  uint32_t seq = c->seq++;
+  uint16_t tamanho = controle_udp_montar(seq, cmds, n, datagrama);
+
+  for (int envio = 1; envio <= tentativas; ++envio) {
+    if (send(c->fd, datagrama, tamanho, 0) != tamanho)
+      return -1;
+    struct pollfd pfd = {.fd = c->fd, .events = POLLIN};
+    while (poll(&pfd, 1, timeout_ms) > 0) {
+      ssize_t r = recv(c->fd, resposta, sizeof(resposta), 0);
+      if (r > 0 && controle_udp_ler_ack(resposta, (uint16_t)r, ack) && ack->seq == seq)
+        return envio;
+      // ack de um envio anterior (atrasado): descarta e continua esperando
+    }
+  }
+  return -1;
+}
+
+bool controle_cliente_ler_comando(const char *texto, controle_cmd_t *cmd) {
+  static const struct {
+    const char *nome;
+    uint8_t id, args;
+  } nomes[] = {
+    {"estado", CONTROLE_CMD_ESTADO, 0},
+    {"comodo", CONTROLE_CMD_COMODO, 1},
+    {"cor", CONTROLE_CMD_COR, 1},
+    {"ligar", CONTROLE_CMD_LIGAR, 1},
+    {"alarme_off", CONTROLE_CMD_ALARME_OFF, 0},
+    {"cena", CONTROLE_CMD_CENA, 3},
+  };
+  const char *dois_pontos = strchr(texto, ':');
+  size_t len = dois_pontos ? (size_t)(dois_pontos - texto) : strlen(texto);
+  for (size_t i = 0; i < sizeof(nomes) / sizeof(nomes[0]); ++i) {
+    if (strlen(nomes[i].nome) != len || strncmp(texto, nomes[i].nome, len))
+      continue;
+    unsigned v[3] = {0, 0, 0};
+    char resto;
+    int lidos = dois_pontos ? sscanf(dois_pontos, ":%u:%u:%u%c", &v[0], &v[1], &v[2], &resto) : 0;
+    if (lidos != nomes[i].args || v[0] > 255 || v[1] > 255 || v[2] > 255)
+      return false;
+    *cmd = (controle_cmd_t){nomes[i].id, v[0], v[1], v[2]};
+    return true;
+  }
+  return false;
+}
+
+const char *controle_cliente_status(uint8_t status) {
+  switch (status) {
+    case CONTROLE_OK: return "ok";
+    case CONTROLE_REPETIDO: return "repetido";
+    case CONTROLE_ANTIGO: return "antigo";
+    case CONTROLE_INVALIDO: return "invalido";
+    default: return "?";
+  }
+}
@@ -0,0 +1,34 @@
+// Cliente do protocolo de controle UDP do painel (lib/controle_udp.h) para Linux
+// Uso típico:
+//   controle_cliente_t c;
+//   controle_cmd_t cena = {CONTROLE_CMD_CENA, 2, 1, 1};
+//   controle_ack_t ack;
+//   if (controle_cliente_abrir(&c, "192.168.0.106", CONTROLE_UDP_PORTA) &&
+//       controle_cliente_enviar(&c, &cena, 1, &ack, 200, 3) > 0) { ... }
+
+#ifndef CONTROLE_UDP_CLIENTE_H
+#define CONTROLE_UDP_CLIENTE_H
+
+#include <netinet/in.h>
+#include "controle_udp.h"
+
+typedef struct {
+  int fd;
+  struct sockaddr_in destino;
+  uint32_t seq;                        // próximo seq (começa em um valor aleatório)
+} controle_cliente_t;
+
+bool controle_cliente_abrir(controle_cliente_t *c, const char *host, uint16_t porta);
+void controle_cliente_fechar(controle_cliente_t *c);
+
+// Envia os comandos em um datagrama e espera o ack do mesmo seq; em caso de silêncio
+// retransmite o mesmo datagrama (seguro: o painel não reaplica um seq repetido).
+// Retorna o número de envios feitos até o ack, ou -1 se nenhum ack chegar.
+int controle_cliente_enviar(controle_cliente_t *c, const controle_cmd_t *cmds, uint8_t n,
+                            controle_ack_t *ack, int timeout_ms, int tentativas);
+
+// "estado", "comodo:2", "cor:1", "ligar:0", "alarme_off", "cena:2:1:1"
+bool controle_cliente_ler_comando(const char *texto, controle_cmd_t *cmd);
+const char *controle_cliente_status(uint8_t status);
+
+#endif
@@ -0,0 +1,30 @@
+// Shim de cyw43.h: estado do driver e estado do enlace da estação
+
+#ifndef SIM_CYW43_H
+#define SIM_CYW43_H
+
+#include "pico.h"
+#include "lwip/netif.h"
+
+#define CYW43_ITF_STA 0
+#define CYW43_ITF_AP 1
+
+#define CYW43_LINK_DOWN 0              // sem associação
+#define CYW43_LINK_JOIN 1              // associando
+#define CYW43_LINK_NOIP 2              // associado, aguardando endereço
+#define CYW43_LINK_UP 3                // associado e com IP
+#define CYW43_LINK_FAIL (-1)
+#define CYW43_LINK_NONET (-2)          // rede não encontrada
+#define CYW43_LINK_BADAUTH (-3)
+
+typedef struct _cyw43_t {
+  struct netif netif[2];
+} cyw43_t;
+
+extern cyw43_t cyw43_state;
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_leave(cyw43_t *self, int itf);
+
+#endif
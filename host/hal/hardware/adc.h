@@ -0,0 +1,14 @@
+// Shim de hardware/adc.h: o canal 4 devolve a temperatura roteirizada
+
+#ifndef SIM_HARDWARE_ADC_H
+#define SIM_HARDWARE_ADC_H
+
+#include "pico.h"
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_set_temp_sensor_enabled(bool enable);
+uint16_t adc_read(void);
+
+#endif
@@ -0,0 +1,29 @@
+// Shim de hardware/clocks.h
+
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+#define SIM_CLK_SYS_HZ 125000000u      // clock padrão do RP2040
+
+enum clock_index {
+  clk_gpout0 = 0,
+  clk_gpout1,
+  clk_gpout2,
+  clk_gpout3,
+  clk_ref,
+  clk_sys,
+  clk_peri,
+  clk_usb,
+  clk_adc,
+  clk_rtc,
+  CLK_COUNT
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index) {
+  (void)clk_index;
+  return SIM_CLK_SYS_HZ;
+}
+
+#endif
@@ -0,0 +1,109 @@
+// Shim de hardware/pio.h: as palavras da FIFO TX viram quadros WS2812 capturados
+
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico.h"
+#include "hardware/gpio.h"
+
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_FIFO_DEPTH 4
+
+enum pio_fifo_join {
+  PIO_FIFO_JOIN_NONE = 0,
+  PIO_FIFO_JOIN_TX = 1,
+  PIO_FIFO_JOIN_RX = 2,
+};
+
+typedef struct pio_program {
+  const uint16_t *instructions;
+  uint8_t length;
+  int8_t origin;
+  uint8_t pio_version;
+} pio_program_t;
+
+typedef struct {
+  uint wrap_target, wrap;
+  uint sideset_bits, sideset_base;
+  uint out_base, out_count;
+  bool out_shift_right, autopull;
+  uint pull_threshold;
+  enum pio_fifo_join join;
+  float clkdiv;
+} pio_sm_config;
+
+typedef struct pio_hw {
+  uint index;
+  uint program_used;
+  uint sm_claimed;
+  volatile uint32_t txf[NUM_PIO_STATE_MACHINES]; // alvo de DMA; o simulador identifica a SM pelo DREQ
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t sim_pio_inst[2];
+
+#define pio0 (&sim_pio_inst[0])
+#define pio1 (&sim_pio_inst[1])
+
+static inline pio_sm_config pio_get_default_sm_config(void) {
+  pio_sm_config c = {0};
+  c.wrap = 31;
+  c.out_shift_right = true;
+  c.pull_threshold = 32;
+  c.clkdiv = 1.0f;
+  return c;
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+  c->wrap_target = wrap_target;
+  c->wrap = wrap;
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+  (void)optional;
+  (void)pindirs;
+  c->sideset_bits = bit_count;
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+  c->sideset_base = sideset_base;
+}
+
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+  c->out_base = out_base;
+  c->out_count = out_count;
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+  c->out_shift_right = shift_right;
+  c->autopull = autopull;
+  c->pull_threshold = pull_threshold;
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+  c->join = join;
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+  c->clkdiv = div;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset);
+void pio_gpio_init(PIO pio, uint pin);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_claim(PIO pio, uint sm);
+void pio_sm_unclaim(PIO pio, uint sm);
+
+// DREQ_PIO0_TX0 = 0 ... DREQ_PIO1_RX3 = 15
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+  return pio->index * 8 + (is_tx ? 0 : 4) + sm;
+}
+
+#endif
@@ -0,0 +1,25 @@
+// Shim de lwip/arch.h: tipos inteiros do lwIP
+
+#ifndef SIM_LWIP_ARCH_H
+#define SIM_LWIP_ARCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lwipopts.h"
+
+typedef uint8_t u8_t;
+typedef int8_t s8_t;
+typedef uint16_t u16_t;
+typedef int16_t s16_t;
+typedef uint32_t u32_t;
+typedef int32_t s32_t;
+
+#define LWIP_UNUSED_ARG(x) (void)x
+
+#ifndef PBUF_POOL_BUFSIZE
+#define PBUF_POOL_BUFSIZE 592          // padrão do opt.h: TCP_MSS (536) + 40 + cabeçalho Ethernet, alinhado
+#endif
+
+typedef u16_t mem_size_t;              // MEM_SIZE < 64KB
+
+#endif
@@ -0,0 +1,11 @@
+// Shim de lwip/dhcp.h: o servidor DHCP virtual entrega 192.168.0.106 após a associação
+
+#ifndef SIM_LWIP_DHCP_H
+#define SIM_LWIP_DHCP_H
+
+#include "lwip/netif.h"
+
+err_t dhcp_start(struct netif *netif);
+void dhcp_stop(struct netif *netif);
+
+#endif
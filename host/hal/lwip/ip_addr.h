@@ -0,0 +1,29 @@
+// Shim de lwip/ip_addr.h (somente IPv4)
+
+#ifndef SIM_LWIP_IP_ADDR_H
+#define SIM_LWIP_IP_ADDR_H
+
+#include "lwip/arch.h"
+
+typedef struct ip4_addr {
+  u32_t addr;                          // ordem de rede, como no lwIP
+} ip_addr_t;
+
+typedef ip_addr_t ip4_addr_t;
+
+extern const ip_addr_t ip_addr_any;
+
+#define IP_ADDR_ANY (&ip_addr_any)
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+  (ipaddr)->addr = ((u32_t)((d) & 0xff) << 24) | ((u32_t)((c) & 0xff) << 16) | ((u32_t)((b) & 0xff) << 8) | (u32_t)((a) & 0xff)
+#define ip4_addr_get_u32(ipaddr) ((ipaddr)->addr)
+#define ip_addr_get_ip4_u32(ipaddr) ip4_addr_get_u32(ipaddr)
+#define ip_addr_isany(ipaddr) ((ipaddr) == NULL || (ipaddr)->addr == 0)
+#define ip4_addr_isany_val(ipaddr) ((ipaddr).addr == 0)
+#define ip4_addr_set_zero(ipaddr) ((ipaddr)->addr = 0)
+
+char *ipaddr_ntoa(const ip_addr_t *addr);
+char *ip4addr_ntoa(const ip4_addr_t *addr);
+int ip4addr_aton(const char *cp, ip4_addr_t *addr);
+
+#endif
@@ -0,0 +1,28 @@
+// Shim de lwip/netif.h: interface única da estação Wi-Fi
+
+#ifndef SIM_LWIP_NETIF_H
+#define SIM_LWIP_NETIF_H
+
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+
+struct netif {
+  ip_addr_t ip_addr;
+  ip_addr_t netmask;
+  ip_addr_t gw;
+  u8_t flags;
+};
+
+#define NETIF_FLAG_UP 0x01U
+#define NETIF_FLAG_LINK_UP 0x04U
+
+extern struct netif *netif_default;
+
+#define netif_ip4_addr(netif) ((const ip4_addr_t *)&((netif)->ip_addr))
+#define netif_ip4_netmask(netif) ((const ip4_addr_t *)&((netif)->netmask))
+#define netif_ip4_gw(netif) ((const ip4_addr_t *)&((netif)->gw))
+#define netif_is_link_up(netif) (((netif)->flags & NETIF_FLAG_LINK_UP) ? 1 : 0)
+
+void netif_set_addr(struct netif *netif, const ip4_addr_t *ipaddr, const ip4_addr_t *netmask, const ip4_addr_t *gw);
+
+#endif
@@ -0,0 +1,22 @@
+// Shim de lwip/stats.h: só as estatísticas do heap (MEM_STATS)
+// O simulador contabiliza os bytes copiados por tcp_write até a confirmação (ver sim/sim_net.c)
+
+#ifndef SIM_LWIP_STATS_H
+#define SIM_LWIP_STATS_H
+
+#include "lwip/arch.h"
+
+struct stats_mem {
+  u16_t err;                           // alocações recusadas por falta de MEM_SIZE
+  mem_size_t avail;
+  mem_size_t used;
+  mem_size_t max;                      // pico de uso desde o boot
+};
+
+struct stats_ {
+  struct stats_mem mem;
+};
+
+extern struct stats_ lwip_stats;
+
+#endif
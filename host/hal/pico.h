@@ -0,0 +1,24 @@
+// Shim do SDK do Pico para compilação no host (Linux)
+// Tipos básicos equivalentes aos de pico/types.h
+
+#ifndef SIM_PICO_H
+#define SIM_PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef PICO_NO_HARDWARE
+#define PICO_NO_HARDWARE 0             // o shim emula o hardware, então os headers gerados pelo pioasm ficam ativos
+#endif
+#define PICO_PIO_VERSION 0             // RP2040 (PIO versão 0)
+#define PICO_ON_DEVICE 0               // sem linker script do RP2040: nada de pintura de pilhas
+
+#define PICO_OK 0                      // códigos de retorno do SDK
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;      // microssegundos desde o boot (modo não opaco do SDK)
+
+#endif
@@ -0,0 +1,14 @@
+// Shim de pico/stdio_usb.h: o stdout do host só conta como porta aberta depois do tempo
+// que um PC leva para enumerar a CDC e o monitor serial abri-la, como na placa
+
+#ifndef SIM_PICO_STDIO_USB_H
+#define SIM_PICO_STDIO_USB_H
+
+#include "pico.h"
+#include "sim.h"
+
+#define SIM_USB_CONECTA_US 1500000     // porta CDC aberta 1,5s após o boot
+
+static inline bool stdio_usb_connected(void) { return sim_now_us() >= SIM_USB_CONECTA_US; }
+
+#endif
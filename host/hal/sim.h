@@ -0,0 +1,40 @@
+// API interna do simulador de host
+// Liga os shims do SDK (gpio, i2c, pio, adc, tempo, rede) ao roteiro e às saídas virtuais
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdio.h>
+#include "pico.h"
+
+#define SIM_MAX_OUTPUT_PATH 256
+
+// relógio simulado
+uint64_t sim_now_us(void);
+void sim_advance_us(uint64_t us);      // avança o relógio e aplica os eventos de entrada vencidos
+void sim_checkpoint(void);             // ponto de sincronização (sleep/poll): rede e fim do roteiro
+
+// entradas roteirizáveis
+void sim_gpio_drive(uint gpio, bool level); // força nível externo (botão pressionado = 0)
+void sim_gpio_release(uint gpio);      // solta o pino (volta ao pull-up/pull-down)
+void sim_adc_set_temperature(float celsius);
+void sim_wifi_set_available(bool available);
+void sim_net_queue_http(const char *path, const char *save_as, uint32_t origem, uint64_t segurar_us); // origem em ordem de rede
+void sim_net_queue_udp(const uint8_t *data, uint16_t len); // datagrama para a porta de controle
+void sim_net_service(void);          // entrega as requisições pendentes aos callbacks TCP
+
+// saídas virtuais
+FILE *sim_output_open(const char *name);
+void sim_oled_dump_pbm(const char *name);
+void sim_oled_report(FILE *out);
+void sim_ws2812_report(FILE *out);
+uint64_t sim_pio_dma_push(uint dreq, const uint32_t *words, uint count); // retorna quando a última palavra entra na FIFO
+void sim_net_report(FILE *out);
+void sim_gpio_report(FILE *out);
+
+// roteiro (sim_main.c)
+void sim_scenario_run_until(uint64_t now_us);
+bool sim_scenario_finished(uint64_t now_us);
+void sim_finish(int code);             // grava as saídas e encerra o processo
+
+#endif
@@ -0,0 +1,186 @@
+// Núcleo do simulador: relógio virtual, GPIOs e ADC
+// O tempo só avança quando o firmware dorme ou ocupa um barramento,
+// então horas de operação rodam em segundos no host
+
+#include <math.h>
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+
+typedef enum { PULL_NONE, PULL_UP, PULL_DOWN } pull_t;
+
+typedef struct {
+  bool out_dir;
+  bool out_value;
+  bool driven;                         // nível imposto pelo roteiro (ex.: botão pressionado)
+  bool drive_level;
+  pull_t pull;
+  enum gpio_function function;
+  uint32_t edges;                      // número de transições da saída
+} sim_gpio_t;
+
+static uint64_t agora_us = 0;          // relógio simulado em microssegundos
+static sim_gpio_t pinos[NUM_BANK0_GPIOS];
+static FILE *gpio_log = NULL;
+static float temperatura_c = 27.0f;    // temperatura informada pelo roteiro
+static uint adc_canal = 0;
+static uint32_t adc_leituras = 0;
+
+uint64_t sim_now_us(void) {
+  return agora_us;
+}
+
+void sim_advance_us(uint64_t us) {
+  agora_us += us;
+  sim_scenario_run_until(agora_us);
+}
+
+bool stdio_init_all(void) {
+  return true;
+}
+
+absolute_time_t get_absolute_time(void) {
+  return agora_us;
+}
+
+uint64_t time_us_64(void) {
+  return agora_us;
+}
+
+uint32_t time_us_32(void) {
+  return (uint32_t)agora_us;
+}
+
+void sleep_us(uint64_t us) {
+  sim_advance_us(us);
+  sim_checkpoint();
+}
+
+void sleep_ms(uint32_t ms) {
+  sleep_us((uint64_t)ms * 1000);
+}
+
+void busy_wait_us(uint64_t us) {
+  sim_advance_us(us);
+}
+
+void busy_wait_until(absolute_time_t t) {
+  if (t > agora_us)
+    sim_advance_us(t - agora_us);
+}
+
+// GPIO
+
+static sim_gpio_t *pino(uint gpio) {
+  if (gpio >= NUM_BANK0_GPIOS) {
+    fprintf(stderr, "sim: GPIO %u inexistente\n", gpio);
+    sim_finish(2);
+  }
+  return &pinos[gpio];
+}
+
+void gpio_init(uint gpio) {
+  sim_gpio_t *p = pino(gpio);
+  p->out_dir = false;
+  p->out_value = false;
+  p->function = GPIO_FUNC_SIO;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+  pino(gpio)->out_dir = out;
+}
+
+void gpio_put(uint gpio, bool value) {
+  sim_gpio_t *p = pino(gpio);
+  if (p->out_value == value)
+    return;
+  p->out_value = value;
+  p->edges++;
+  if (!gpio_log)
+    gpio_log = sim_output_open("gpio.log");
+  if (gpio_log)
+    fprintf(gpio_log, "%llu.%03llu GPIO%u=%d\n",
+            (unsigned long long)(agora_us / 1000), (unsigned long long)(agora_us % 1000), gpio, value);
+}
+
+bool gpio_get(uint gpio) {
+  sim_gpio_t *p = pino(gpio);
+  if (p->out_dir)
+    return p->out_value;
+  if (p->driven)
+    return p->drive_level;
+  return p->pull == PULL_UP;
+}
+
+void gpio_pull_up(uint gpio) {
+  pino(gpio)->pull = PULL_UP;
+}
+
+void gpio_pull_down(uint gpio) {
+  pino(gpio)->pull = PULL_DOWN;
+}
+
+void gpio_disable_pulls(uint gpio) {
+  pino(gpio)->pull = PULL_NONE;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+  pino(gpio)->function = fn;
+}
+
+void sim_gpio_drive(uint gpio, bool level) {
+  sim_gpio_t *p = pino(gpio);
+  p->driven = true;
+  p->drive_level = level;
+}
+
+void sim_gpio_release(uint gpio) {
+  pino(gpio)->driven = false;
+}
+
+void sim_gpio_report(FILE *out) {
+  for (uint i = 0; i < NUM_BANK0_GPIOS; ++i) {
+    if (pinos[i].out_dir && pinos[i].edges)
+      fprintf(out, "gpio%u_edges=%u\n", i, pinos[i].edges);
+  }
+  if (gpio_log)
+    fflush(gpio_log);
+  fprintf(out, "adc_reads=%u\n", adc_leituras);
+}
+
+// ADC: apenas o sensor interno (canal 4) é modelado
+
+void adc_init(void) {
+}
+
+void adc_gpio_init(uint gpio) {
+  gpio_set_function(gpio, GPIO_FUNC_NULL);
+}
+
+void adc_select_input(uint input) {
+  adc_canal = input;
+}
+
+void adc_set_temp_sensor_enabled(bool enable) {
+  (void)enable;
+}
+
+uint16_t adc_read(void) {
+  adc_leituras++;
+  sim_advance_us(2);                   // conversão de 96 ciclos a 48MHz
+  if (adc_canal != 4)
+    return 0;
+  // inverso de T = 27 - (V - 0.706) / 0.001721, com Vref = 3.3V e 12 bits
+  double volts = 0.706 - ((double)temperatura_c - 27.0) * 0.001721;
+  long bruto = lround(volts * (1 << 12) / 3.3);
+  if (bruto < 0)
+    bruto = 0;
+  if (bruto > 4095)
+    bruto = 4095;
+  return (uint16_t)bruto;
+}
+
+void sim_adc_set_temperature(float celsius) {
+  temperatura_c = celsius;
+}
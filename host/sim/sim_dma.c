@@ -0,0 +1,86 @@
+// DMA virtual: só o caminho memória -> FIFO TX do PIO, usado pelas fitas WS2812
+
+#include "sim.h"
+#include "hardware/dma.h"
+
+typedef struct {
+  bool claimed;
+  dma_channel_config config;
+  const volatile void *read_addr;
+  uint transfer_count;
+  uint64_t busy_until_ns;              // última palavra entra na FIFO
+  uint64_t transfers, words;
+} sim_dma_t;
+
+static sim_dma_t canais[NUM_DMA_CHANNELS];
+
+static sim_dma_t *canal(uint channel) {
+  if (channel >= NUM_DMA_CHANNELS) {
+    fprintf(stderr, "sim: canal DMA %u inexistente\n", channel);
+    sim_finish(2);
+  }
+  return &canais[channel];
+}
+
+int dma_claim_unused_channel(bool required) {
+  for (uint i = 0; i < NUM_DMA_CHANNELS; ++i) {
+    if (!canais[i].claimed) {
+      canais[i].claimed = true;
+      return (int)i;
+    }
+  }
+  if (required) {
+    fprintf(stderr, "sim: nenhum canal DMA livre\n");
+    sim_finish(2);
+  }
+  return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+  canal(channel)->claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+  (void)channel;
+  dma_channel_config c = {DMA_SIZE_32, true, false, 0x3f};
+  return c;
+}
+
+static void disparar(sim_dma_t *c) {
+  if (c->config.dreq >= 16 || c->config.size != DMA_SIZE_32 || !c->config.read_increment) {
+    fprintf(stderr, "sim: transferência DMA não suportada (dreq %u)\n", c->config.dreq);
+    sim_finish(2);
+  }
+  c->transfers++;
+  c->words += c->transfer_count;
+  c->busy_until_ns = sim_pio_dma_push(c->config.dreq, (const uint32_t *)c->read_addr, c->transfer_count);
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+  (void)write_addr;
+  sim_dma_t *c = canal(channel);
+  c->config = *config;
+  c->read_addr = read_addr;
+  c->transfer_count = transfer_count;
+  if (trigger)
+    disparar(c);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+  sim_dma_t *c = canal(channel);
+  c->read_addr = read_addr;
+  c->transfer_count = transfer_count;
+  disparar(c);
+}
+
+bool dma_channel_is_busy(uint channel) {
+  return canal(channel)->busy_until_ns > sim_now_us() * 1000;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+  uint64_t agora = sim_now_us() * 1000;
+  sim_dma_t *c = canal(channel);
+  if (c->busy_until_ns > agora)
+    sim_advance_us((c->busy_until_ns - agora + 999) / 1000);
+}
@@ -0,0 +1,367 @@
+// Simulador de host do painel: roda o firmware (main.c) sobre os shims do SDK
+// Uso: smart_home_sim [-o pasta] [-t duracao] [-q] roteiro.txt
+//
+// Formato do roteiro (uma ação por linha, '#' inicia comentário):
+//   fim <tempo>                          duração total da simulação
+//   <tempo> temp <celsius>               temperatura lida pelo sensor interno
+//   <tempo> botao <A|B|JOY> <duracao>    pressiona um botão pelo tempo indicado
+//   <tempo> gpio <pino> <0|1|solto>      força (ou solta) o nível de uma entrada
+//   <tempo> http <caminho> [ip=A.B.C.D] [segurar=<tempo>] [arquivo]
+//                                        requisição GET ao webserver (resposta opcional em arquivo),
+//                                        vinda de ip (padrão 192.168.0.50); com segurar, o cliente
+//                                        conecta e só envia a requisição após o tempo indicado
+//   <tempo> udp [seq=N] <comando...>     datagrama de controle UDP (comandos de
+//                                        controle_udp_cliente.h, ex.: cena:1:2:1 cor:3)
+//   <tempo> oled <arquivo.pbm>           grava a imagem do display
+//   <tempo> wifi <on|off>                disponibilidade da rede (off derruba o enlace na hora)
+//   <tempo> a_cada <periodo> <acao...>   repete a ação até o fim
+// Tempos em ms, ou com sufixos h, m, s e ms (ex.: 1500, 30s, 1h2m)
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "hardware/gpio.h"
+#include "controle_udp_cliente.h"
+#include "lwip/ip_addr.h"
+
+#define MAX_EVENTOS 4096
+#define BOTAO_A 5                      // mesmos pinos da BitDogLab usados em main.c
+#define BOTAO_B 6
+#define JOYSTICK 22
+
+typedef enum { EV_TEMP, EV_DRIVE, EV_RELEASE, EV_HTTP, EV_OLED, EV_WIFI, EV_UDP } tipo_evento_t;
+
+typedef struct {
+  uint64_t at_us;
+  uint64_t periodo_us;                 // 0 = evento único
+  uint32_t seq;                        // desempate: ordem do roteiro
+  tipo_evento_t tipo;
+  uint pino;
+  float valor;
+  char texto[128];
+  char extra[64];
+  controle_cmd_t cmds[8];              // comandos do datagrama UDP
+  uint8_t num_cmds;
+  bool seq_fixo;                       // seq dado no roteiro (senão, sequencial)
+  uint32_t seq_udp;
+  ip_addr_t origem;                    // cliente da requisição HTTP
+  uint64_t segurar_us;                 // espera entre conectar e enviar a requisição
+} evento_t;
+
+int firmware_main(void);               // main() do firmware, renomeada na compilação
+
+static evento_t heap[MAX_EVENTOS];     // fila de prioridade por instante
+static size_t num_eventos = 0;
+static uint32_t proximo_seq = 0;
+static uint64_t fim_us = 0;
+static const char *pasta_saida = "sim_out";
+static struct timespec inicio_real;
+static uint32_t proximo_seq_udp = 1;
+
+static bool antes(const evento_t *a, const evento_t *b) {
+  return a->at_us < b->at_us || (a->at_us == b->at_us && a->seq < b->seq);
+}
+
+static void agendar(evento_t ev) {
+  if (num_eventos == MAX_EVENTOS) {
+    fprintf(stderr, "sim: roteiro excede %d eventos\n", MAX_EVENTOS);
+    exit(2);
+  }
+  ev.seq = proximo_seq++;
+  size_t i = num_eventos++;
+  while (i && antes(&ev, &heap[(i - 1) / 2])) {
+    heap[i] = heap[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  heap[i] = ev;
+}
+
+static evento_t retirar(void) {
+  evento_t topo = heap[0];
+  evento_t ultimo = heap[--num_eventos];
+  size_t i = 0;
+  for (;;) {
+    size_t f = 2 * i + 1;
+    if (f >= num_eventos)
+      break;
+    if (f + 1 < num_eventos && antes(&heap[f + 1], &heap[f]))
+      f++;
+    if (!antes(&heap[f], &ultimo))
+      break;
+    heap[i] = heap[f];
+    i = f;
+  }
+  if (num_eventos)
+    heap[i] = ultimo;
+  return topo;
+}
+
+static void enviar_udp(const evento_t *ev) {
+  uint8_t datagrama[CONTROLE_UDP_MAX_DATAGRAMA];
+  uint32_t seq = ev->seq_fixo ? ev->seq_udp : proximo_seq_udp;
+  if ((int32_t)(seq + 1 - proximo_seq_udp) > 0)
+    proximo_seq_udp = seq + 1;         // os seqs automáticos seguem o maior já enviado
+  sim_net_queue_udp(datagrama, controle_udp_montar(seq, ev->cmds, ev->num_cmds, datagrama));
+}
+
+static void aplicar(const evento_t *ev) {
+  switch (ev->tipo) {
+    case EV_TEMP: sim_adc_set_temperature(ev->valor); break;
+    case EV_DRIVE: sim_gpio_drive(ev->pino, ev->valor != 0.0f); break;
+    case EV_RELEASE: sim_gpio_release(ev->pino); break;
+    case EV_HTTP: sim_net_queue_http(ev->texto, ev->extra[0] ? ev->extra : NULL, ev->origem.addr, ev->segurar_us); break;
+    case EV_OLED: sim_oled_dump_pbm(ev->texto); break;
+    case EV_WIFI: sim_wifi_set_available(ev->valor != 0.0f); break;
+    case EV_UDP: enviar_udp(ev); break;
+  }
+}
+
+void sim_scenario_run_until(uint64_t now_us) {
+  while (num_eventos && heap[0].at_us <= now_us) {
+    evento_t ev = retirar();
+    aplicar(&ev);
+    if (ev.periodo_us && ev.at_us + ev.periodo_us < fim_us) {
+      ev.at_us += ev.periodo_us;
+      agendar(ev);
+    }
+  }
+}
+
+bool sim_scenario_finished(uint64_t now_us) {
+  return now_us >= fim_us;
+}
+
+void sim_checkpoint(void) {
+  sim_net_service();
+  if (sim_scenario_finished(sim_now_us()))
+    sim_finish(0);
+}
+
+FILE *sim_output_open(const char *name) {
+  char caminho[SIM_MAX_OUTPUT_PATH];
+  snprintf(caminho, sizeof(caminho), "%s/%s", pasta_saida, name);
+  FILE *f = fopen(caminho, "w");
+  if (!f)
+    fprintf(stderr, "sim: não foi possível criar %s: %s\n", caminho, strerror(errno));
+  return f;
+}
+
+static void resumo(FILE *out, int code) {
+  struct timespec agora;
+  clock_gettime(CLOCK_MONOTONIC, &agora);
+  double real_s = (agora.tv_sec - inicio_real.tv_sec) + (agora.tv_nsec - inicio_real.tv_nsec) / 1e9;
+  double sim_s = sim_now_us() / 1e6;
+  fprintf(out, "exit_code=%d\n", code);
+  fprintf(out, "sim_time_ms=%llu\n", (unsigned long long)(sim_now_us() / 1000));
+  fprintf(out, "wall_time_s=%.3f\n", real_s);
+  fprintf(out, "speedup=%.0f\n", real_s > 0 ? sim_s / real_s : 0.0);
+  sim_oled_report(out);
+  sim_ws2812_report(out);
+  sim_net_report(out);
+  sim_gpio_report(out);
+}
+
+void sim_finish(int code) {
+  fflush(stdout);
+  sim_oled_dump_pbm("oled.pbm");
+  FILE *f = sim_output_open("summary.txt");
+  if (f) {
+    resumo(f, code);
+    fclose(f);
+  }
+  resumo(stderr, code);
+  exit(code);
+}
+
+// "1500" = 1500ms; aceita sufixos h, m, s e ms combinados (ex.: 1h30m, 2m15s)
+static bool ler_tempo(const char *s, uint64_t *us) {
+  double total = 0;
+  const char *p = s;
+  do {
+    char *fim;
+    double v = strtod(p, &fim);
+    if (fim == p || v < 0)
+      return false;
+    double escala;
+    if (!strncmp(fim, "ms", 2)) {
+      escala = 1e3;
+      fim += 2;
+    } else if (*fim == 'h') {
+      escala = 3600e6;
+      fim++;
+    } else if (*fim == 'm') {
+      escala = 60e6;
+      fim++;
+    } else if (*fim == 's') {
+      escala = 1e6;
+      fim++;
+    } else if (*fim == '\0' && p == s) {
+      escala = 1e3;                    // número puro: milissegundos
+    } else {
+      return false;
+    }
+    total += v * escala;
+    p = fim;
+  } while (*p);
+  *us = (uint64_t)total;
+  return true;
+}
+
+static bool ler_pino(const char *s, uint *pino) {
+  if (!strcmp(s, "A"))
+    *pino = BOTAO_A;
+  else if (!strcmp(s, "B"))
+    *pino = BOTAO_B;
+  else if (!strcmp(s, "JOY"))
+    *pino = JOYSTICK;
+  else {
+    char *fim;
+    long n = strtol(s, &fim, 10);
+    if (*fim || n < 0 || n >= NUM_BANK0_GPIOS)
+      return false;
+    *pino = (uint)n;
+  }
+  return true;
+}
+
+// interpreta uma ação a partir de tok[0]; retorna falso se a linha for inválida
+static bool interpretar(char **tok, int n, uint64_t at, uint64_t periodo) {
+  evento_t ev = {.at_us = at, .periodo_us = periodo};
+  if (n < 2)
+    return false;
+  if (!strcmp(tok[0], "a_cada") && !periodo) {
+    uint64_t p;
+    return n >= 3 && ler_tempo(tok[1], &p) && p > 0 && interpretar(tok + 2, n - 2, at, p);
+  } else if (!strcmp(tok[0], "temp")) {
+    ev.tipo = EV_TEMP;
+    ev.valor = strtof(tok[1], NULL);
+  } else if (!strcmp(tok[0], "botao") && n == 3) {
+    uint64_t duracao;
+    if (!ler_pino(tok[1], &ev.pino) || !ler_tempo(tok[2], &duracao))
+      return false;
+    ev.tipo = EV_DRIVE;                // botões da placa são ativos em nível baixo
+    ev.valor = 0;
+    agendar(ev);
+    ev.tipo = EV_RELEASE;
+    ev.at_us = at + duracao;
+  } else if (!strcmp(tok[0], "gpio") && n == 3) {
+    if (!ler_pino(tok[1], &ev.pino))
+      return false;
+    ev.tipo = strcmp(tok[2], "solto") ? EV_DRIVE : EV_RELEASE;
+    ev.valor = strcmp(tok[2], "0") ? 1.0f : 0.0f;
+  } else if (!strcmp(tok[0], "http")) {
+    ev.tipo = EV_HTTP;
+    snprintf(ev.texto, sizeof(ev.texto), "%s", tok[1]);
+    IP4_ADDR(&ev.origem, 192, 168, 0, 50); // mesmo cliente virtual do UDP
+    for (int i = 2; i < n; ++i) {
+      if (!strncmp(tok[i], "ip=", 3)) {
+        if (!ip4addr_aton(tok[i] + 3, &ev.origem))
+          return false;
+      } else if (!strncmp(tok[i], "segurar=", 8)) {
+        if (!ler_tempo(tok[i] + 8, &ev.segurar_us))
+          return false;
+      } else {
+        snprintf(ev.extra, sizeof(ev.extra), "%s", tok[i]);
+      }
+    }
+  } else if (!strcmp(tok[0], "oled")) {
+    ev.tipo = EV_OLED;
+    snprintf(ev.texto, sizeof(ev.texto), "%s", tok[1]);
+  } else if (!strcmp(tok[0], "udp")) {
+    ev.tipo = EV_UDP;
+    for (int i = 1; i < n; ++i) {
+      if (!strncmp(tok[i], "seq=", 4)) {
+        ev.seq_fixo = true;
+        ev.seq_udp = strtoul(tok[i] + 4, NULL, 10);
+      } else if (ev.num_cmds == sizeof(ev.cmds) / sizeof(ev.cmds[0]) ||
+                 !controle_cliente_ler_comando(tok[i], &ev.cmds[ev.num_cmds++])) {
+        return false;
+      }
+    }
+  } else if (!strcmp(tok[0], "wifi")) {
+    ev.tipo = EV_WIFI;
+    ev.valor = !strcmp(tok[1], "on") ? 1.0f : 0.0f;
+  } else {
+    return false;
+  }
+  agendar(ev);
+  return true;
+}
+
+static void carregar_roteiro(const char *caminho) {
+  FILE *f = fopen(caminho, "r");
+  if (!f) {
+    fprintf(stderr, "sim: roteiro %s: %s\n", caminho, strerror(errno));
+    exit(2);
+  }
+  char linha[256];
+  int num_linha = 0;
+  while (fgets(linha, sizeof(linha), f)) {
+    num_linha++;
+    char *comentario = strchr(linha, '#');
+    if (comentario)
+      *comentario = '\0';
+    char *tok[8];
+    int n = 0;
+    for (char *t = strtok(linha, " \t\r\n"); t && n < 8; t = strtok(NULL, " \t\r\n"))
+      tok[n++] = t;
+    if (!n)
+      continue;
+    uint64_t at;
+    bool ok;
+    if (!strcmp(tok[0], "fim"))
+      ok = n == 2 && ler_tempo(tok[1], &fim_us);
+    else
+      ok = ler_tempo(tok[0], &at) && interpretar(tok + 1, n - 1, at, 0);
+    if (!ok) {
+      fprintf(stderr, "sim: %s:%d: linha inválida\n", caminho, num_linha);
+      exit(2);
+    }
+  }
+  fclose(f);
+}
+
+static void uso(const char *prog) {
+  fprintf(stderr, "uso: %s [-o pasta] [-t duracao] [-q] roteiro.txt\n", prog);
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint64_t duracao = 0;
+  bool silencioso = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "o:t:q")) != -1) {
+    switch (opt) {
+      case 'o': pasta_saida = optarg; break;
+      case 't': if (!ler_tempo(optarg, &duracao)) uso(argv[0]); break;
+      case 'q': silencioso = true; break;
+      default: uso(argv[0]);
+    }
+  }
+  if (optind < argc)
+    carregar_roteiro(argv[optind]);
+  else if (!duracao)
+    uso(argv[0]);
+  if (duracao)
+    fim_us = duracao;
+  if (!fim_us) {
+    fprintf(stderr, "sim: defina a duração com 'fim' no roteiro ou -t\n");
+    return 2;
+  }
+  if (mkdir(pasta_saida, 0755) && errno != EEXIST) {
+    fprintf(stderr, "sim: pasta %s: %s\n", pasta_saida, strerror(errno));
+    return 2;
+  }
+  if (silencioso && !freopen("/dev/null", "w", stdout))
+    return 2;
+
+  clock_gettime(CLOCK_MONOTONIC, &inicio_real);
+  sim_scenario_run_until(0);
+  int ret = firmware_main();
+  fprintf(stderr, "sim: firmware retornou %d\n", ret);
+  sim_finish(ret ? 1 : 0);
+}
@@ -0,0 +1,659 @@
+// Wi-Fi e lwIP virtuais: a estação associa após SIM_WIFI_ASSOC_MS (ou falha, se o
+// roteiro derrubar a rede), recebe o endereço do DHCP virtual e as requisições HTTP e
+// os datagramas UDP do roteiro são entregues aos callbacks registrados pelo firmware,
+// como faria o lwIP no modo NO_SYS
+
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/tcp.h"
+#include "lwip/netif.h"
+#include "lwip/dhcp.h"
+#include "lwip/udp.h"
+#include "lwip/stats.h"
+#include "controle_udp.h"
+#include "controle_udp_cliente.h"
+
+#define SIM_WIFI_ASSOC_MS 1000         // varredura + associação WPA2 em uma rede real típica
+#define SIM_WIFI_DHCP_MS 500           // DISCOVER/OFFER/REQUEST/ACK após a associação
+#define SIM_WIFI_NONET_MS 3000         // varredura completa sem encontrar a rede
+#define SIM_HTTP_RTT_US 2000           // handshake e transferência em LAN
+#define SIM_UDP_RTT_US 1000            // ida e volta de um datagrama em LAN
+#define SIM_UDP_CLIENTE_PORTA 40000    // porta de origem do cliente virtual (192.168.0.50)
+#define SIM_MAX_PENDING 64
+#define SIM_POLL_US 500000             // período do tcp_slowtmr do lwIP (unidade de tcp_poll)
+
+struct udp_pcb {
+  u16_t port;
+  udp_recv_fn recv;
+  void *arg;
+};
+
+typedef struct {
+  uint8_t dados[CONTROLE_UDP_MAX_DATAGRAMA];
+  uint16_t tamanho;
+} udp_pendente_t;
+
+typedef enum { ENLACE_DESLIGADO, ENLACE_ASSOCIANDO, ENLACE_ASSOCIADO, ENLACE_FALHOU } enlace_t;
+
+typedef struct {
+  char path[128];
+  char save_as[64];
+  ip_addr_t origem;                    // IP do cliente
+  uint64_t segurar_us;                 // espera entre conectar e enviar a requisição
+  uint64_t envio_us;                   // instante do envio, para conexões seguradas
+  struct tcp_pcb *conn;                // conexão aberta aguardando o envio
+} http_pendente_t;
+
+const ip_addr_t ip_addr_any = {0};
+
+cyw43_t cyw43_state;
+struct netif *netif_default = NULL;
+static struct netif *const sta = &cyw43_state.netif[CYW43_ITF_STA];
+
+static bool wifi_disponivel = true;
+static bool wifi_iniciado = false;
+static enlace_t enlace = ENLACE_DESLIGADO;
+static uint64_t enlace_prazo_us = 0;   // fim da associação em andamento
+static bool dhcp_ativo = true;
+static uint64_t wifi_associacoes = 0, wifi_falhas = 0, wifi_quedas = 0;
+static uint64_t wifi_sobrepostas = 0;  // associações iniciadas com outra ainda em curso no driver
+static struct tcp_pcb *listeners[MEMP_NUM_TCP_PCB];
+static http_pendente_t pendentes[SIM_MAX_PENDING];
+static size_t num_pendentes = 0;
+static http_pendente_t abertas[SIM_MAX_PENDING]; // conexões aceitas cuja requisição ainda não foi enviada
+static size_t num_abertas = 0;
+static FILE *http_log = NULL;
+static struct udp_pcb *udp_pcbs[MEMP_NUM_UDP_PCB];
+static udp_pendente_t udp_pendentes[SIM_MAX_PENDING];
+static size_t num_udp_pendentes = 0;
+static uint8_t udp_resposta[64];       // último datagrama enviado pelo firmware
+static uint16_t udp_resposta_len = 0;
+static FILE *udp_log = NULL;
+static uint64_t udp_datagramas = 0, udp_acks = 0, udp_sem_resposta = 0;
+static uint64_t pbufs_alocados = 0, pbufs_liberados = 0;
+static uint64_t http_requisicoes = 0, http_recusadas = 0, http_bytes = 0;
+static uint64_t http_rst = 0, http_429 = 0, http_ociosas = 0;
+static uint64_t http_sem_pcb = 0;      // SYNs descartados com o pool de PCBs cheio
+static size_t pcbs_em_uso = 0, pcbs_pico = 0; // PCBs de conexão (MEMP_NUM_TCP_PCB; escutas ficam à parte)
+struct stats_ lwip_stats;              // heap do lwIP: cópias de tcp_write ainda não confirmadas
+
+// Wi-Fi
+
+int cyw43_arch_init(void) {
+  wifi_iniciado = true;
+  netif_default = sta;                 // a interface existe desde o init, ainda sem IP
+  return 0;
+}
+
+void cyw43_arch_deinit(void) {
+  wifi_iniciado = false;
+  enlace = ENLACE_DESLIGADO;
+  memset(sta, 0, sizeof(*sta));
+  netif_default = NULL;
+}
+
+void cyw43_arch_enable_sta_mode(void) {
+}
+
+static void perder_enlace(void) {
+  sta->flags &= ~NETIF_FLAG_LINK_UP;
+  ip4_addr_set_zero(&sta->ip_addr);    // o lease some com o enlace; cabe ao firmware reaproveitá-lo
+}
+
+// avança a associação e o DHCP em andamento até o instante atual
+static void atualizar_enlace(void) {
+  uint64_t agora = sim_now_us();
+  if (enlace == ENLACE_ASSOCIANDO && agora >= enlace_prazo_us) {
+    if (wifi_disponivel) {
+      enlace = ENLACE_ASSOCIADO;
+      sta->flags |= NETIF_FLAG_UP | NETIF_FLAG_LINK_UP;
+      wifi_associacoes++;
+    } else {
+      enlace = ENLACE_FALHOU;
+      wifi_falhas++;
+    }
+  }
+  if (enlace == ENLACE_ASSOCIADO && dhcp_ativo && ip4_addr_isany_val(sta->ip_addr) &&
+      agora >= enlace_prazo_us + (uint64_t)SIM_WIFI_DHCP_MS * 1000) {
+    IP4_ADDR(&sta->ip_addr, 192, 168, 0, 106);
+    IP4_ADDR(&sta->netmask, 255, 255, 255, 0);
+    IP4_ADDR(&sta->gw, 192, 168, 0, 1);
+  }
+}
+
+int cyw43_arch_wifi_connect_async(const char *ssid, const char *pw, uint32_t auth) {
+  (void)ssid;
+  (void)pw;
+  (void)auth;
+  if (!wifi_iniciado)
+    return PICO_ERROR_GENERIC;
+  if (enlace == ENLACE_ASSOCIANDO)
+    wifi_sobrepostas++;                // o firmware devia ter chamado cyw43_wifi_leave antes
+  perder_enlace();                     // uma nova associação derruba a anterior
+  enlace = ENLACE_ASSOCIANDO;
+  enlace_prazo_us = sim_now_us() + (uint64_t)(wifi_disponivel ? SIM_WIFI_ASSOC_MS : SIM_WIFI_NONET_MS) * 1000;
+  return 0;
+}
+
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout) {
+  int err = cyw43_arch_wifi_connect_async(ssid, pw, auth);
+  if (err)
+    return err;
+  uint64_t fim = sim_now_us() + (uint64_t)timeout * 1000;
+  while (sim_now_us() < fim) {
+    int status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    if (status == CYW43_LINK_UP)
+      return 0;
+    if (status < 0)
+      return PICO_ERROR_GENERIC;
+    sim_advance_us(10000);
+  }
+  return PICO_ERROR_TIMEOUT;
+}
+
+int cyw43_wifi_link_status(cyw43_t *self, int itf) {
+  (void)self;
+  if (itf != CYW43_ITF_STA)
+    return CYW43_LINK_DOWN;
+  atualizar_enlace();
+  switch (enlace) {
+    case ENLACE_ASSOCIADO: return CYW43_LINK_JOIN;
+    case ENLACE_FALHOU: return CYW43_LINK_NONET;
+    default: return CYW43_LINK_DOWN;
+  }
+}
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf) {
+  int status = cyw43_wifi_link_status(self, itf);
+  if (enlace == ENLACE_ASSOCIANDO && itf == CYW43_ITF_STA)
+    return CYW43_LINK_JOIN;
+  if (status != CYW43_LINK_JOIN)
+    return status;
+  return ip4_addr_isany_val(sta->ip_addr) ? CYW43_LINK_NOIP : CYW43_LINK_UP;
+}
+
+// desassocia e cancela a associação em curso
+int cyw43_wifi_leave(cyw43_t *self, int itf) {
+  (void)self;
+  if (itf != CYW43_ITF_STA)
+    return 0;
+  enlace = ENLACE_DESLIGADO;
+  perder_enlace();
+  return 0;
+}
+
+err_t dhcp_start(struct netif *netif) {
+  (void)netif;
+  dhcp_ativo = true;
+  return ERR_OK;
+}
+
+void dhcp_stop(struct netif *netif) {
+  (void)netif;
+  dhcp_ativo = false;
+}
+
+void netif_set_addr(struct netif *netif, const ip4_addr_t *ipaddr, const ip4_addr_t *netmask, const ip4_addr_t *gw) {
+  netif->ip_addr = *ipaddr;
+  netif->netmask = *netmask;
+  netif->gw = *gw;
+}
+
+void cyw43_arch_poll(void) {
+  sim_checkpoint();
+}
+
+// os callbacks só rodam nos pontos de sincronização, então a trava não tem efeito
+void cyw43_arch_lwip_begin(void) {
+}
+
+void cyw43_arch_lwip_end(void) {
+}
+
+// "wifi off" derruba o enlace na hora, como um roteador reiniciando; "wifi on" só
+// devolve a rede, a reassociação fica por conta do firmware
+void sim_wifi_set_available(bool available) {
+  wifi_disponivel = available;
+  if (!available && enlace == ENLACE_ASSOCIADO) {
+    enlace = ENLACE_DESLIGADO;
+    perder_enlace();
+    wifi_quedas++;
+  }
+}
+
+int ip4addr_aton(const char *cp, ip4_addr_t *addr) {
+  unsigned a, b, c, d;
+  char resto;
+  if (sscanf(cp, "%u.%u.%u.%u%c", &a, &b, &c, &d, &resto) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+    return 0;
+  IP4_ADDR(addr, a, b, c, d);
+  return 1;
+}
+
+char *ip4addr_ntoa(const ip4_addr_t *addr) {
+  static char buf[16];
+  u32_t a = addr->addr;
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", a & 0xff, (a >> 8) & 0xff, (a >> 16) & 0xff, a >> 24);
+  return buf;
+}
+
+char *ipaddr_ntoa(const ip_addr_t *addr) {
+  return ip4addr_ntoa(addr);
+}
+
+// pbuf
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type) {
+  (void)layer;
+  (void)type;
+  struct pbuf *p = malloc(sizeof(struct pbuf) + length);
+  p->next = NULL;
+  p->payload = p + 1;
+  p->len = p->tot_len = length;
+  pbufs_alocados++;
+  return p;
+}
+
+static struct pbuf *pbuf_criar(const void *data, u16_t len) {
+  struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, len, PBUF_RAM);
+  memcpy(p->payload, data, len);
+  return p;
+}
+
+u8_t pbuf_free(struct pbuf *p) {
+  if (!p)
+    return 0;
+  pbufs_liberados++;
+  free(p);
+  return 1;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset) {
+  if (offset >= p->len)
+    return 0;
+  if (len > p->len - offset)
+    len = p->len - offset;
+  memcpy(dataptr, (const u8_t *)p->payload + offset, len);
+  return len;
+}
+
+// TCP
+
+struct tcp_pcb *tcp_new(void) {
+  return calloc(1, sizeof(struct tcp_pcb));
+}
+
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port) {
+  (void)ipaddr;
+  for (size_t i = 0; i < MEMP_NUM_TCP_PCB; ++i) {
+    if (listeners[i] && listeners[i]->port == port)
+      return ERR_USE;
+  }
+  pcb->port = port;
+  return ERR_OK;
+}
+
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog) {
+  (void)backlog;
+  for (size_t i = 0; i < MEMP_NUM_TCP_PCB; ++i) {
+    if (!listeners[i]) {
+      pcb->listening = true;
+      listeners[i] = pcb;
+      return pcb;
+    }
+  }
+  return NULL;
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg) {
+  pcb->arg = arg;
+}
+
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept) {
+  pcb->accept = accept;
+}
+
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv) {
+  pcb->recv = recv;
+}
+
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) {
+  pcb->sent = sent;
+}
+
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) {
+  pcb->err = err;
+}
+
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval) {
+  pcb->poll = poll;
+  pcb->poll_interval = interval;
+  pcb->next_poll_us = sim_now_us() + interval * (uint64_t)SIM_POLL_US;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len) {
+  (void)pcb;
+  (void)len;
+}
+
+u16_t tcp_sndbuf(const struct tcp_pcb *pcb) {
+  return (u16_t)(TCP_SND_BUF - pcb->unsent);
+}
+
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags) {
+  if (pcb->closed)
+    return ERR_CONN;
+  if (len > tcp_sndbuf(pcb))
+    return ERR_MEM;
+  if (apiflags & TCP_WRITE_FLAG_COPY) { // a cópia sai do heap de MEM_SIZE bytes
+    if (lwip_stats.mem.used + len > MEM_SIZE) {
+      lwip_stats.mem.err++;
+      return ERR_MEM;
+    }
+    lwip_stats.mem.used += len;
+    if (lwip_stats.mem.used > lwip_stats.mem.max)
+      lwip_stats.mem.max = lwip_stats.mem.used;
+    pcb->unsent_heap += len;
+  }
+  if (pcb->tx_len + len > pcb->tx_cap) {
+    pcb->tx_cap = (pcb->tx_len + len) * 2;
+    pcb->tx = realloc(pcb->tx, pcb->tx_cap);
+  }
+  memcpy(pcb->tx + pcb->tx_len, dataptr, len);
+  pcb->tx_len += len;
+  pcb->unsent += len;
+  return ERR_OK;
+}
+
+err_t tcp_output(struct tcp_pcb *pcb) {
+  lwip_stats.mem.used -= pcb->unsent_heap; // a LAN simulada confirma tudo imediatamente
+  pcb->unsent = pcb->unsent_heap = 0;
+  return ERR_OK;
+}
+
+err_t tcp_close(struct tcp_pcb *pcb) {
+  if (pcb->listening) {
+    for (size_t i = 0; i < MEMP_NUM_TCP_PCB; ++i) {
+      if (listeners[i] == pcb)
+        listeners[i] = NULL;
+    }
+    free(pcb);
+    return ERR_OK;
+  }
+  pcb->closed = true;                  // conexões são liberadas pelo simulador após a troca
+  return ERR_OK;
+}
+
+void tcp_abort(struct tcp_pcb *pcb) {
+  tcp_close(pcb);
+}
+
+// UDP
+
+struct udp_pcb *udp_new(void) {
+  return calloc(1, sizeof(struct udp_pcb));
+}
+
+err_t udp_bind(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port) {
+  (void)ipaddr;
+  for (size_t i = 0; i < MEMP_NUM_UDP_PCB; ++i) {
+    if (udp_pcbs[i] && udp_pcbs[i]->port == port)
+      return ERR_USE;
+  }
+  for (size_t i = 0; i < MEMP_NUM_UDP_PCB; ++i) {
+    if (!udp_pcbs[i]) {
+      pcb->port = port;
+      udp_pcbs[i] = pcb;
+      return ERR_OK;
+    }
+  }
+  return ERR_MEM;
+}
+
+void udp_recv(struct udp_pcb *pcb, udp_recv_fn recv, void *recv_arg) {
+  pcb->recv = recv;
+  pcb->arg = recv_arg;
+}
+
+err_t udp_sendto(struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *dst_ip, u16_t dst_port) {
+  (void)pcb;
+  (void)dst_ip;
+  (void)dst_port;
+  udp_resposta_len = p->len < sizeof(udp_resposta) ? p->len : sizeof(udp_resposta);
+  memcpy(udp_resposta, p->payload, udp_resposta_len);
+  return ERR_OK;
+}
+
+void udp_remove(struct udp_pcb *pcb) {
+  for (size_t i = 0; i < MEMP_NUM_UDP_PCB; ++i) {
+    if (udp_pcbs[i] == pcb)
+      udp_pcbs[i] = NULL;
+  }
+  free(pcb);
+}
+
+// requisições do roteiro
+
+// descarta a conexão; o que ficou sem tcp_output volta ao heap do lwIP
+static void liberar_conexao(struct tcp_pcb *conn) {
+  pcbs_em_uso--;
+  lwip_stats.mem.used -= conn->unsent_heap;
+  free(conn->tx);
+  free(conn);
+}
+
+void sim_net_queue_http(const char *path, const char *save_as, uint32_t origem, uint64_t segurar_us) {
+  if (num_pendentes == SIM_MAX_PENDING) {
+    fprintf(stderr, "sim: fila HTTP cheia, requisição %s descartada\n", path);
+    return;
+  }
+  http_pendente_t *h = &pendentes[num_pendentes++];
+  snprintf(h->path, sizeof(h->path), "%s", path);
+  snprintf(h->save_as, sizeof(h->save_as), "%s", save_as ? save_as : "");
+  h->origem.addr = origem;
+  h->segurar_us = segurar_us;
+}
+
+static void registrar(const http_pendente_t *h, const struct tcp_pcb *conn, const char *resultado) {
+  if (!http_log)
+    http_log = sim_output_open("http.log");
+  if (!http_log)
+    return;
+  const char *fim = conn && conn->tx_len ? memchr(conn->tx, '\r', conn->tx_len) : NULL;
+  int status_len = fim ? (int)(fim - conn->tx) : 0;
+  fprintf(http_log, "%llu %s GET %s -> %s %.*s (%zu bytes)\n",
+          (unsigned long long)(sim_now_us() / 1000), ipaddr_ntoa(&h->origem), h->path, resultado,
+          status_len, conn && conn->tx ? conn->tx : "", conn ? conn->tx_len : (size_t)0);
+}
+
+// envia a requisição numa conexão aceita, lê a resposta e fecha
+static void entregar(const http_pendente_t *h, struct tcp_pcb *conn) {
+  char req[256];
+  int n = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n",
+                   h->path, ipaddr_ntoa(&sta->ip_addr));
+  struct pbuf *p = pbuf_criar(req, (u16_t)n);
+  if (conn->recv)
+    conn->recv(conn->arg, conn, p, ERR_OK);
+  else
+    pbuf_free(p);
+  if (conn->sent && conn->tx_len && !conn->closed)
+    conn->sent(conn->arg, conn, (u16_t)conn->tx_len);
+  if (!conn->closed && conn->recv)     // o navegador fecha após receber a página
+    conn->recv(conn->arg, conn, NULL, ERR_OK);
+
+  http_bytes += conn->tx_len;
+  if (conn->tx_len > 12 && !memcmp(conn->tx + 9, "429", 3))
+    http_429++;
+  registrar(h, conn, "ok");
+  if (h->save_as[0]) {
+    FILE *f = sim_output_open(h->save_as);
+    if (f) {
+      fwrite(conn->tx, 1, conn->tx_len, f);
+      fclose(f);
+    }
+  }
+  liberar_conexao(conn);
+}
+
+static void atender(const http_pendente_t *h) {
+  struct tcp_pcb *listener = NULL;
+  for (size_t i = 0; i < MEMP_NUM_TCP_PCB; ++i) {
+    if (listeners[i] && listeners[i]->port == 80 && listeners[i]->accept)
+      listener = listeners[i];
+  }
+  http_requisicoes++;
+  atualizar_enlace();
+  if (!listener || !(sta->flags & NETIF_FLAG_LINK_UP) || ip4_addr_isany_val(sta->ip_addr)) {
+    http_recusadas++;
+    registrar(h, NULL, "recusada");
+    return;
+  }
+
+  sim_advance_us(SIM_HTTP_RTT_US);
+  if (pcbs_em_uso == MEMP_NUM_TCP_PCB) { // o lwIP não tem PCB para o SYN: o cliente não conecta
+    http_recusadas++;
+    http_sem_pcb++;
+    registrar(h, NULL, "sem PCB");
+    return;
+  }
+  struct tcp_pcb *conn = tcp_new();
+  if (++pcbs_em_uso > pcbs_pico)
+    pcbs_pico = pcbs_em_uso;
+  conn->arg = listener->arg;
+  conn->remote_ip = h->origem;
+  conn->remote_port = 50000 + (u16_t)(http_requisicoes % 10000); // porta efêmera do cliente
+  if (listener->accept(listener->arg, conn, ERR_OK) != ERR_OK || conn->closed) {
+    http_recusadas++;
+    http_rst++;
+    registrar(h, conn, "rejeitada");
+    liberar_conexao(conn);
+    return;
+  }
+  if (h->segurar_us && num_abertas < SIM_MAX_PENDING) { // cliente lento: a requisição vem depois
+    http_pendente_t *a = &abertas[num_abertas++];
+    *a = *h;
+    a->conn = conn;
+    a->envio_us = sim_now_us() + h->segurar_us;
+    return;
+  }
+  entregar(h, conn);
+}
+
+// conexões seguradas: envia as que venceram e chama o tcp_poll das demais, que o
+// firmware usa para fechar clientes ociosos
+static void atender_abertas(void) {
+  uint64_t agora = sim_now_us();
+  for (size_t i = 0; i < num_abertas;) {
+    http_pendente_t *a = &abertas[i];
+    struct tcp_pcb *conn = a->conn;
+    if (!conn->closed && conn->poll && agora >= conn->next_poll_us) {
+      conn->next_poll_us += conn->poll_interval * (uint64_t)SIM_POLL_US;
+      conn->poll(conn->arg, conn);
+    }
+    if (!conn->closed && agora < a->envio_us) {
+      ++i;
+      continue;
+    }
+    http_pendente_t h = *a;
+    abertas[i] = abertas[--num_abertas];
+    if (conn->closed) {                // fechada pelo servidor antes da requisição
+      http_ociosas++;
+      registrar(&h, conn, "fechada pelo servidor");
+      liberar_conexao(conn);
+    } else {
+      entregar(&h, conn);
+    }
+  }
+}
+
+void sim_net_queue_udp(const uint8_t *data, uint16_t len) {
+  if (num_udp_pendentes == SIM_MAX_PENDING || len > CONTROLE_UDP_MAX_DATAGRAMA) {
+    fprintf(stderr, "sim: datagrama UDP descartado\n");
+    return;
+  }
+  udp_pendente_t *u = &udp_pendentes[num_udp_pendentes++];
+  memcpy(u->dados, data, len);
+  u->tamanho = len;
+}
+
+static void entregar_udp(const udp_pendente_t *u) {
+  if (!udp_log)
+    udp_log = sim_output_open("udp.log");
+  struct udp_pcb *pcb = NULL;
+  for (size_t i = 0; i < MEMP_NUM_UDP_PCB; ++i) {
+    if (udp_pcbs[i] && udp_pcbs[i]->port == CONTROLE_UDP_PORTA && udp_pcbs[i]->recv)
+      pcb = udp_pcbs[i];
+  }
+  udp_datagramas++;
+  uint32_t seq = u->dados[4] | (uint32_t)u->dados[5] << 8 | (uint32_t)u->dados[6] << 16 | (uint32_t)u->dados[7] << 24;
+  uint64_t envio_us = sim_now_us();
+  atualizar_enlace();
+  udp_resposta_len = 0;
+  if (pcb && (sta->flags & NETIF_FLAG_LINK_UP) && !ip4_addr_isany_val(sta->ip_addr)) {
+    ip_addr_t origem;
+    IP4_ADDR(&origem, 192, 168, 0, 50);
+    sim_advance_us(SIM_UDP_RTT_US / 2);
+    pcb->recv(pcb->arg, pcb, pbuf_criar(u->dados, u->tamanho), &origem, SIM_UDP_CLIENTE_PORTA);
+  }
+
+  controle_ack_t ack;
+  if (!udp_resposta_len || !controle_udp_ler_ack(udp_resposta, udp_resposta_len, &ack)) {
+    udp_sem_resposta++;
+    if (udp_log)
+      fprintf(udp_log, "%llu seq=%u cmds=%u -> sem resposta\n", (unsigned long long)(envio_us / 1000),
+              seq, (u->tamanho - CONTROLE_UDP_CABECALHO) / 4);
+    return;
+  }
+  sim_advance_us(SIM_UDP_RTT_US / 2);
+  udp_acks++;
+  if (udp_log)
+    fprintf(udp_log, "%llu seq=%u cmds=%u -> %s aplicados=%u comodo=%u cor=%u ligado=%u emergencia=%u (%llu us)\n",
+            (unsigned long long)(envio_us / 1000), ack.seq, (u->tamanho - CONTROLE_UDP_CABECALHO) / 4,
+            controle_cliente_status(ack.status), ack.aplicados, ack.estado.comodo, ack.estado.cor,
+            ack.estado.ligado, ack.estado.emergencia, (unsigned long long)(sim_now_us() - envio_us));
+}
+
+void sim_net_service(void) {
+  // copia a fila: os callbacks podem avançar o relógio e enfileirar novas requisições
+  http_pendente_t lote[SIM_MAX_PENDING];
+  size_t n = num_pendentes;
+  memcpy(lote, pendentes, n * sizeof(http_pendente_t));
+  num_pendentes = 0;
+  for (size_t i = 0; i < n; ++i)
+    atender(&lote[i]);
+  atender_abertas();
+
+  udp_pendente_t udp_lote[SIM_MAX_PENDING];
+  n = num_udp_pendentes;
+  memcpy(udp_lote, udp_pendentes, n * sizeof(udp_pendente_t));
+  num_udp_pendentes = 0;
+  for (size_t i = 0; i < n; ++i)
+    entregar_udp(&udp_lote[i]);
+}
+
+void sim_net_report(FILE *out) {
+  fprintf(out, "http_requests=%llu\n", (unsigned long long)http_requisicoes);
+  fprintf(out, "http_refused=%llu\n", (unsigned long long)http_recusadas);
+  fprintf(out, "http_response_bytes=%llu\n", (unsigned long long)http_bytes);
+  fprintf(out, "http_reset=%llu\n", (unsigned long long)http_rst);
+  fprintf(out, "http_throttled=%llu\n", (unsigned long long)http_429);
+  fprintf(out, "http_idle_closed=%llu\n", (unsigned long long)http_ociosas);
+  fprintf(out, "http_no_pcb=%llu\n", (unsigned long long)http_sem_pcb);
+  fprintf(out, "tcp_pcb_max=%zu\n", pcbs_pico);
+  fprintf(out, "lwip_mem_max=%u\n", lwip_stats.mem.max);
+  fprintf(out, "lwip_mem_errors=%u\n", lwip_stats.mem.err);
+  fprintf(out, "pbuf_leaks=%llu\n", (unsigned long long)(pbufs_alocados - pbufs_liberados));
+  fprintf(out, "udp_datagrams=%llu\n", (unsigned long long)udp_datagramas);
+  fprintf(out, "udp_acks=%llu\n", (unsigned long long)udp_acks);
+  fprintf(out, "udp_unanswered=%llu\n", (unsigned long long)udp_sem_resposta);
+  fprintf(out, "wifi_joins=%llu\n", (unsigned long long)wifi_associacoes);
+  fprintf(out, "wifi_join_failures=%llu\n", (unsigned long long)wifi_falhas);
+  fprintf(out, "wifi_link_losses=%llu\n", (unsigned long long)wifi_quedas);
+  fprintf(out, "wifi_join_overlaps=%llu\n", (unsigned long long)wifi_sobrepostas);
+  if (http_log)
+    fflush(http_log);
+  if (udp_log)
+    fflush(udp_log);
+}
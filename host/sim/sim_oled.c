@@ -0,0 +1,182 @@
+// Barramento I2C virtual com um SSD1306 128x64 no endereço 0x3C
+// O fluxo de bytes é decodificado como no controlador real (bytes de controle,
+// comandos com argumentos e modos de endereçamento) e vira um framebuffer
+
+#include <string.h>
+#include "sim.h"
+#include "hardware/i2c.h"
+
+#define OLED_ADDR 0x3C
+#define OLED_COLS 128
+#define OLED_PAGES 8
+
+i2c_inst_t sim_i2c_inst[2] = {{0, 100000}, {1, 100000}};
+
+typedef struct {
+  uint8_t gddram[OLED_PAGES][OLED_COLS]; // memória de vídeo do controlador
+  uint8_t mode;                        // 0 horizontal, 1 vertical, 2 página
+  uint8_t col, col_start, col_end;
+  uint8_t page, page_start, page_end;
+  bool display_on, inverted, entire_on;
+  uint8_t cmd[8];                      // comando em montagem (opcode + argumentos)
+  uint8_t cmd_len, cmd_need;
+} ssd1306_sim_t;
+
+static ssd1306_sim_t oled = {
+  .mode = 2, .col_end = OLED_COLS - 1, .page_end = OLED_PAGES - 1,
+};
+
+static uint64_t i2c_transacoes = 0;
+static uint64_t i2c_bytes = 0;
+static uint64_t i2c_comandos = 0;
+static uint64_t i2c_dados = 0;
+static uint64_t i2c_nacks = 0;
+
+// número de argumentos de cada comando do SSD1306
+static uint8_t argumentos(uint8_t op) {
+  switch (op) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    case 0x21: case 0x22: case 0xA3:
+      return 2;
+    case 0x29: case 0x2A:
+      return 5;
+    case 0x26: case 0x27:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+static void executar_comando(const uint8_t *c) {
+  uint8_t op = c[0];
+  if (op <= 0x0F) {
+    oled.col = (oled.col & 0xF0) | op;
+  } else if (op <= 0x1F) {
+    oled.col = (oled.col & 0x0F) | ((op & 0x0F) << 4);
+  } else if (op == 0x20) {
+    oled.mode = c[1] & 0x03;
+  } else if (op == 0x21) {
+    oled.col_start = c[1] & 0x7F;
+    oled.col_end = c[2] & 0x7F;
+    oled.col = oled.col_start;
+  } else if (op == 0x22) {
+    oled.page_start = c[1] & 0x07;
+    oled.page_end = c[2] & 0x07;
+    oled.page = oled.page_start;
+  } else if (op >= 0xB0 && op <= 0xB7) {
+    oled.page = op & 0x07;
+  } else if (op == 0xA4 || op == 0xA5) {
+    oled.entire_on = op & 1;
+  } else if (op == 0xA6 || op == 0xA7) {
+    oled.inverted = op & 1;
+  } else if (op == 0xAE || op == 0xAF) {
+    oled.display_on = op & 1;
+  }
+  // demais comandos (contraste, remapeamento, clock, bomba de carga...) não afetam a imagem lógica
+}
+
+static void receber_comando(uint8_t byte) {
+  i2c_comandos++;
+  if (oled.cmd_len == 0)
+    oled.cmd_need = 1 + argumentos(byte);
+  oled.cmd[oled.cmd_len++] = byte;
+  if (oled.cmd_len == oled.cmd_need) {
+    executar_comando(oled.cmd);
+    oled.cmd_len = 0;
+  }
+}
+
+static void receber_dado(uint8_t byte) {
+  i2c_dados++;
+  oled.gddram[oled.page][oled.col] = byte;
+  if (oled.mode == 0) {                // horizontal: coluna, depois página
+    if (oled.col++ >= oled.col_end) {
+      oled.col = oled.col_start;
+      oled.page = oled.page >= oled.page_end ? oled.page_start : oled.page + 1;
+    }
+  } else if (oled.mode == 1) {         // vertical: página, depois coluna
+    if (oled.page++ >= oled.page_end) {
+      oled.page = oled.page_start;
+      oled.col = oled.col >= oled.col_end ? oled.col_start : oled.col + 1;
+    }
+  } else {                             // página: só a coluna avança
+    oled.col = (oled.col + 1) & 0x7F;
+  }
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+  i2c->baudrate = baudrate;
+  return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  // start + endereço + dados, 9 bits por byte (ACK incluso), + stop
+  sim_advance_us(((uint64_t)(len + 1) * 9 + 2) * 1000000 / i2c->baudrate);
+  i2c_transacoes++;
+  i2c_bytes += len + 1;
+  if (addr != OLED_ADDR) {
+    i2c_nacks++;
+    return PICO_ERROR_GENERIC;
+  }
+
+  size_t i = 0;
+  while (i < len) {
+    uint8_t controle = src[i++];
+    bool dado = controle & 0x40;
+    if (controle & 0x80) {             // Co = 1: um único byte segue este controle
+      if (i < len)
+        dado ? receber_dado(src[i]) : receber_comando(src[i]);
+      i++;
+    } else {                           // Co = 0: o resto da transação é um fluxo contínuo
+      for (; i < len; ++i)
+        dado ? receber_dado(src[i]) : receber_comando(src[i]);
+    }
+  }
+  (void)nostop;
+  return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+  (void)nostop;
+  sim_advance_us(((uint64_t)(len + 1) * 9 + 2) * 1000000 / i2c->baudrate);
+  i2c_transacoes++;
+  if (addr != OLED_ADDR)
+    return PICO_ERROR_GENERIC;
+  memset(dst, 0, len);                 // status do SSD1306: display ligado não é reportado
+  return (int)len;
+}
+
+// grava o que o painel mostraria, no formato PBM binário (P4)
+void sim_oled_dump_pbm(const char *name) {
+  FILE *f = sim_output_open(name);
+  if (!f)
+    return;
+  fprintf(f, "P4\n# SSD1306 t=%llums\n%d %d\n",
+          (unsigned long long)(sim_now_us() / 1000), OLED_COLS, OLED_PAGES * 8);
+  for (int y = 0; y < OLED_PAGES * 8; ++y) {
+    uint8_t linha[OLED_COLS / 8] = {0};
+    for (int x = 0; x < OLED_COLS; ++x) {
+      bool aceso = (oled.gddram[y >> 3][x] >> (y & 7)) & 1;
+      if (oled.entire_on)
+        aceso = true;
+      if (oled.inverted)
+        aceso = !aceso;
+      if (!oled.display_on)
+        aceso = false;
+      if (aceso)                       // no PBM, 1 é preto: pixel aceso é desenhado em preto
+        linha[x >> 3] |= 0x80 >> (x & 7);
+    }
+    fwrite(linha, 1, sizeof(linha), f);
+  }
+  fclose(f);
+}
+
+void sim_oled_report(FILE *out) {
+  fprintf(out, "i2c_transactions=%llu\n", (unsigned long long)i2c_transacoes);
+  fprintf(out, "i2c_bytes=%llu\n", (unsigned long long)i2c_bytes);
+  fprintf(out, "oled_command_bytes=%llu\n", (unsigned long long)i2c_comandos);
+  fprintf(out, "oled_data_bytes=%llu\n", (unsigned long long)i2c_dados);
+  fprintf(out, "i2c_nacks=%llu\n", (unsigned long long)i2c_nacks);
+}
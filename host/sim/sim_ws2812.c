@@ -0,0 +1,254 @@
+// PIO virtual: as palavras escritas na FIFO TX são decodificadas como bits WS2812
+// Um quadro termina quando a linha fica parada por mais que o tempo de reset (latch),
+// exatamente como a fita real decide quando aplicar as cores.
+// Dois programas são reconhecidos pela configuração da SM:
+//  - ws2812: side-set em um pino, um bit por ciclo de bit (24 bits por palavra)
+//  - ws2812_paralelo: "out pins" em até 8 pinos, um plano de 8 bits por ciclo de bit
+
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "hardware/clocks.h"
+#include "hardware/pio.h"
+
+#define WS2812_CYCLES_PER_BIT 10       // T1 + T2 + T3 dos programas ws2812*.pio
+#define WS2812_RESET_NS 50000          // linha em repouso por 50us trava o quadro
+#define TX_FIFO_WORDS 8                // FIFO TX com join: 8 palavras
+#define PLANE_BITS 8                   // bits por plano no programa paralelo
+#define MAX_LANES 8
+
+typedef struct {
+  uint pin;
+  uint32_t *frame;                     // quadro em transmissão
+  uint32_t *last;                      // último quadro travado
+  size_t frame_len, last_len, cap;
+  uint32_t acc;                        // pixel em montagem (modo paralelo)
+} sim_lane_t;
+
+typedef struct {
+  pio_sm_config config;
+  bool enabled;
+  bool parallel;
+  uint num_lanes;
+  sim_lane_t lanes[MAX_LANES];
+  uint planes;                         // planos já recebidos do pixel em montagem
+  uint64_t word_ns;                    // tempo para serializar uma palavra
+  uint64_t drain_until_ns;             // instante em que a FIFO e o shift register esvaziam
+  uint64_t frame_start_ns;
+  uint64_t frames, changed_frames, words, stalls_us;
+} sim_sm_t;
+
+pio_hw_t sim_pio_inst[2] = {{.index = 0}, {.index = 1}};
+
+static sim_sm_t maquinas[2][NUM_PIO_STATE_MACHINES];
+static FILE *ws2812_log = NULL;
+
+static sim_sm_t *maquina(PIO pio, uint sm) {
+  if (sm >= NUM_PIO_STATE_MACHINES) {
+    fprintf(stderr, "sim: state machine %u inexistente\n", sm);
+    sim_finish(2);
+  }
+  return &maquinas[pio->index][sm];
+}
+
+static void lane_push(sim_lane_t *l, uint32_t pixel) {
+  if (l->frame_len == l->cap) {
+    l->cap = l->cap ? l->cap * 2 : 32;
+    l->frame = realloc(l->frame, l->cap * sizeof(uint32_t));
+    l->last = realloc(l->last, l->cap * sizeof(uint32_t));
+  }
+  l->frame[l->frame_len++] = pixel;
+}
+
+static uint32_t decodificar(const pio_sm_config *c, uint32_t data) {
+  uint bits = c->pull_threshold ? c->pull_threshold : 32;
+  if (!c->out_shift_right)
+    return bits == 32 ? data : data >> (32 - bits);
+  uint32_t v = 0;                      // shift à direita: o bit 0 sai primeiro
+  for (uint i = 0; i < bits; ++i)
+    v = (v << 1) | ((data >> i) & 1);
+  return v;
+}
+
+static void receber_palavra(sim_sm_t *m, uint32_t data) {
+  if (!m->parallel) {
+    lane_push(&m->lanes[0], decodificar(&m->config, data));
+    return;
+  }
+  for (uint p = 0; p < 32 / PLANE_BITS; ++p) {
+    uint desl = m->config.out_shift_right ? p * PLANE_BITS : 32 - (p + 1) * PLANE_BITS;
+    uint8_t plano = data >> desl;
+    for (uint l = 0; l < m->num_lanes; ++l)
+      m->lanes[l].acc = (m->lanes[l].acc << 1) | ((plano >> l) & 1);
+    if (++m->planes == 24) {
+      for (uint l = 0; l < m->num_lanes; ++l) {
+        lane_push(&m->lanes[l], m->lanes[l].acc & 0xFFFFFF);
+        m->lanes[l].acc = 0;
+      }
+      m->planes = 0;
+    }
+  }
+}
+
+// trava o quadro em transmissão e registra as fitas que mudaram
+static void travar_quadro(PIO pio, uint sm, sim_sm_t *m) {
+  if (!m->lanes[0].frame_len)
+    return;
+  m->frames++;
+  bool algum = false;
+  for (uint i = 0; i < m->num_lanes; ++i) {
+    sim_lane_t *l = &m->lanes[i];
+    bool mudou = l->frame_len != l->last_len ||
+                 memcmp(l->frame, l->last, l->frame_len * sizeof(uint32_t)) != 0;
+    if (mudou) {
+      algum = true;
+      if (!ws2812_log)
+        ws2812_log = sim_output_open("ws2812.log");
+      if (ws2812_log) {
+        fprintf(ws2812_log, "%llu.%03llu pio%u sm%u gpio%u n=%zu",
+                (unsigned long long)(m->frame_start_ns / 1000000),
+                (unsigned long long)(m->frame_start_ns / 1000 % 1000), pio->index, sm, l->pin, l->frame_len);
+        for (size_t k = 0; k < l->frame_len; ++k)
+          fprintf(ws2812_log, " %06x", l->frame[k]);
+        fputc('\n', ws2812_log);
+      }
+    }
+    uint32_t *t = l->last;
+    l->last = l->frame;
+    l->frame = t;
+    l->last_len = l->frame_len;
+    l->frame_len = 0;
+  }
+  if (algum)
+    m->changed_frames++;
+}
+
+// coloca uma palavra na FIFO no instante "pedido_ns" (ou assim que houver espaço);
+// retorna o instante em que ela de fato entrou
+static uint64_t empurrar(PIO pio, uint sm, sim_sm_t *m, uint32_t data, uint64_t pedido_ns) {
+  uint64_t entrada = pedido_ns;
+  if (m->drain_until_ns > entrada + TX_FIFO_WORDS * m->word_ns)
+    entrada = m->drain_until_ns - TX_FIFO_WORDS * m->word_ns;
+  if (m->lanes[0].frame_len && entrada >= m->drain_until_ns + WS2812_RESET_NS)
+    travar_quadro(pio, sm, m);
+  uint64_t inicio = entrada > m->drain_until_ns ? entrada : m->drain_until_ns;
+  if (!m->lanes[0].frame_len && !m->planes)
+    m->frame_start_ns = inicio;
+  m->drain_until_ns = inicio + m->word_ns;
+  m->words++;
+  receber_palavra(m, data);
+  return entrada;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+  return pio->program_used + program->length <= 32;
+}
+
+// como no SDK, carregar sem espaço é erro fatal
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+  if (!pio_can_add_program(pio, program)) {
+    fprintf(stderr, "sim: sem espaço para o programa no pio%u\n", pio->index);
+    sim_finish(2);
+  }
+  uint offset = 32 - pio->program_used - program->length;
+  pio->program_used += program->length;
+  return offset;
+}
+
+// a memória de instruções é uma pilha: só o último programa carregado volta a ficar livre
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset) {
+  if (loaded_offset == 32 - pio->program_used)
+    pio->program_used -= program->length;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+  for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+    if (!(pio->sm_claimed & (1u << sm))) {
+      pio->sm_claimed |= 1u << sm;
+      return (int)sm;
+    }
+  }
+  if (required) {
+    fprintf(stderr, "sim: nenhuma state machine livre no pio%u\n", pio->index);
+    sim_finish(2);
+  }
+  return -1;
+}
+
+void pio_sm_claim(PIO pio, uint sm) {
+  pio->sm_claimed |= 1u << sm;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm) {
+  pio->sm_claimed &= ~(1u << sm);
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+  gpio_set_function(pin, pio->index ? GPIO_FUNC_PIO1 : GPIO_FUNC_PIO0);
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+  (void)pio;
+  (void)sm;
+  (void)pin_base;
+  (void)pin_count;
+  (void)is_out;
+  return PICO_OK;
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+  (void)initial_pc;
+  sim_sm_t *m = maquina(pio, sm);
+  m->config = *config;
+  m->parallel = config->out_count > 0 && config->sideset_bits == 0;
+  m->num_lanes = m->parallel ? (config->out_count < MAX_LANES ? config->out_count : MAX_LANES) : 1;
+  for (uint l = 0; l < m->num_lanes; ++l)
+    m->lanes[l].pin = (m->parallel ? config->out_base : config->sideset_base) + l;
+  uint bits = config->pull_threshold ? config->pull_threshold : 32;
+  uint ciclos_de_bit = m->parallel ? bits / PLANE_BITS : bits;
+  double ns = ciclos_de_bit * WS2812_CYCLES_PER_BIT * (double)config->clkdiv * 1e9 / SIM_CLK_SYS_HZ;
+  m->word_ns = (uint64_t)(ns + 0.5);
+  return PICO_OK;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+  maquina(pio, sm)->enabled = enabled;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+  sim_sm_t *m = maquina(pio, sm);
+  uint64_t agora = sim_now_us() * 1000;
+  uint64_t entrada = empurrar(pio, sm, m, data, agora);
+  if (entrada > agora) {               // FIFO cheia: a CPU esperou por espaço
+    uint64_t espera_us = (entrada - agora + 999) / 1000;
+    m->stalls_us += espera_us;
+    sim_advance_us(espera_us);
+  }
+}
+
+uint64_t sim_pio_dma_push(uint dreq, const uint32_t *words, uint count) {
+  PIO pio = &sim_pio_inst[dreq / 8];
+  uint sm = dreq % 4;
+  sim_sm_t *m = maquina(pio, sm);
+  uint64_t t = sim_now_us() * 1000;
+  for (uint i = 0; i < count; ++i)
+    t = empurrar(pio, sm, m, words[i], t);
+  return t;
+}
+
+void sim_ws2812_report(FILE *out) {
+  for (uint p = 0; p < 2; ++p) {
+    for (uint s = 0; s < NUM_PIO_STATE_MACHINES; ++s) {
+      sim_sm_t *m = &maquinas[p][s];
+      travar_quadro(&sim_pio_inst[p], s, m);
+      if (!m->words)
+        continue;
+      fprintf(out, "pio%u_sm%u_frames=%llu\n", p, s, (unsigned long long)m->frames);
+      fprintf(out, "pio%u_sm%u_changed_frames=%llu\n", p, s, (unsigned long long)m->changed_frames);
+      fprintf(out, "pio%u_sm%u_words=%llu\n", p, s, (unsigned long long)m->words);
+      fprintf(out, "pio%u_sm%u_fifo_stall_us=%llu\n", p, s, (unsigned long long)m->stalls_us);
+    }
+  }
+  if (ws2812_log)
+    fflush(ws2812_log);
+}
@@ -0,0 +1,166 @@
+// Teste do protocolo de controle UDP (lib/controle_udp.c), chamando controle_udp_processar direto
+//  - retransmissão do último seq: ack original com status REPETIDO, sem reaplicar
+//  - seq mais antigo que o último aplicado: ANTIGO, estado intacto
+//  - datagrama com um comando inválido no meio: INVALIDO e nada aplicado, nem os válidos
+//  - datagramas que não são de comandos não recebem resposta
+//  - tabela de CONTROLE_UDP_CLIENTES: o cliente visto há mais tempo é substituído, e o seq
+//    de um cliente em silêncio por mais de CONTROLE_UDP_JANELA_MS é esquecido
+
+#include <stdio.h>
+#include <string.h>
+
+#include "controle_udp.h"
+
+#define IP_A 0x0A00A8C0u               // 192.168.0.10 em ordem de rede
+#define IP_B 0x0B00A8C0u               // 192.168.0.11
+#define PORTA 50000
+
+static int falhas = 0;
+static controle_estado_t estado;
+
+#define CONFERIR(cond, ...)                                                    \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: ", __FILE__, __LINE__);                                   \
+      printf(__VA_ARGS__);                                                     \
+      printf("\n");                                                            \
+      falhas++;                                                                \
+    }                                                                          \
+  } while (0)
+
+// monta e processa um datagrama; o ack é lido de volta como faria o cliente
+static controle_ack_t enviar(uint32_t ip, uint16_t porta, uint32_t agora_ms, uint32_t seq,
+                             const controle_cmd_t *cmds, uint8_t n) {
+  uint8_t datagrama[CONTROLE_UDP_MAX_DATAGRAMA], resposta[CONTROLE_UDP_ACK_BYTES];
+  uint16_t tamanho = controle_udp_montar(seq, cmds, n, datagrama);
+  controle_ack_t ack = {0};
+  uint16_t ack_len = controle_udp_processar(datagrama, tamanho, ip, porta, agora_ms, &estado, resposta);
+  CONFERIR(ack_len == CONTROLE_UDP_ACK_BYTES && controle_udp_ler_ack(resposta, ack_len, &ack),
+           "seq %lu sem ack válido (%u bytes)", (unsigned long)seq, ack_len);
+  CONFERIR(ack.seq == seq, "ack com seq %lu, esperado %lu", (unsigned long)ack.seq, (unsigned long)seq);
+  return ack;
+}
+
+static bool mesmo_estado(const controle_estado_t *a, const controle_estado_t *b) {
+  return a->comodo == b->comodo && a->cor == b->cor && a->ligado == b->ligado && a->emergencia == b->emergencia;
+}
+
+static void testar_sequencia(void) {
+  const controle_cmd_t cena[] = {{CONTROLE_CMD_CENA, 1, 2, 1}};
+  controle_ack_t ack = enviar(IP_A, PORTA, 1000, 1, cena, 1);
+  CONFERIR(ack.status == CONTROLE_OK && ack.aplicados == 1, "cena: status %u, %u aplicados", ack.status, ack.aplicados);
+  CONFERIR(estado.comodo == 1 && estado.cor == 2 && estado.ligado, "cena não aplicada");
+
+  // retransmissão: o conteúdo é ignorado e o ack original volta como REPETIDO
+  controle_estado_t antes = estado;
+  const controle_cmd_t outra_cena[] = {{CONTROLE_CMD_CENA, 3, 5, 0}};
+  ack = enviar(IP_A, PORTA, 1100, 1, outra_cena, 1);
+  CONFERIR(ack.status == CONTROLE_REPETIDO && ack.aplicados == 1, "retransmissão: status %u, %u aplicados",
+           ack.status, ack.aplicados);
+  CONFERIR(mesmo_estado(&estado, &antes) && mesmo_estado(&ack.estado, &antes), "retransmissão reaplicou comandos");
+
+  const controle_cmd_t cor[] = {{CONTROLE_CMD_COR, 4, 0, 0}};
+  ack = enviar(IP_A, PORTA, 1200, 2, cor, 1);
+  CONFERIR(ack.status == CONTROLE_OK && estado.cor == 4, "seq 2: status %u, cor %u", ack.status, estado.cor);
+
+  // datagrama atrasado: não desfaz a cor do seq 2
+  antes = estado;
+  ack = enviar(IP_A, PORTA, 1300, 1, cena, 1);
+  CONFERIR(ack.status == CONTROLE_ANTIGO && ack.aplicados == 0, "seq antigo: status %u, %u aplicados",
+           ack.status, ack.aplicados);
+  CONFERIR(mesmo_estado(&estado, &antes), "seq antigo alterou o estado");
+
+  // seq comparado em aritmética modular: avanços de menos de 2^31 valem, inclusive na volta para 0
+  const uint32_t voltas[] = {0x70000000u, 0xE0000000u, 0xFFFFFFFFu, 0};
+  for (uint32_t i = 0; i < 4; ++i) {
+    ack = enviar(IP_A, PORTA, 1400 + i, voltas[i], cor, 1);
+    CONFERIR(ack.status == CONTROLE_OK, "seq %#lx: status %u", (unsigned long)voltas[i], ack.status);
+  }
+}
+
+static void testar_invalidos(void) {
+  const controle_cmd_t ligar[] = {{CONTROLE_CMD_CENA, 0, 0, 1}};
+  enviar(IP_A, PORTA, 2000, 10, ligar, 1);
+  controle_estado_t antes = estado;
+
+  // comandos válidos antes e depois do inválido: nenhum pode ser aplicado
+  const controle_cmd_t mistos[][3] = {
+    {{CONTROLE_CMD_COR, 5, 0, 0}, {CONTROLE_CMD_COMODO, CONTROLE_UDP_COMODOS, 0, 0}, {CONTROLE_CMD_LIGAR, 0, 0, 0}},
+    {{CONTROLE_CMD_COR, 5, 0, 0}, {CONTROLE_CMD_LIGAR, 0, 0, 0}, {CONTROLE_CMD_CENA, 1, CONTROLE_UDP_CORES, 1}},
+    {{CONTROLE_CMD_LIGAR, 0, 0, 0}, {0x7F, 0, 0, 0}, {CONTROLE_CMD_COR, 5, 0, 0}},
+    {{CONTROLE_CMD_LIGAR, 2, 0, 0}, {CONTROLE_CMD_COR, 5, 0, 0}, {CONTROLE_CMD_COMODO, 2, 0, 0}},
+  };
+  const uint8_t indice_invalido[] = {1, 2, 1, 0};
+  for (uint32_t i = 0; i < sizeof(mistos) / sizeof(mistos[0]); ++i) {
+    controle_ack_t ack = enviar(IP_A, PORTA, 2100 + i, 11 + i, mistos[i], 3);
+    CONFERIR(ack.status == CONTROLE_INVALIDO && ack.aplicados == indice_invalido[i],
+             "misto %lu: status %u, índice %u (esperado %u)", (unsigned long)i, ack.status, ack.aplicados,
+             indice_invalido[i]);
+    CONFERIR(mesmo_estado(&estado, &antes) && mesmo_estado(&ack.estado, &antes), "misto %lu alterou o estado",
+             (unsigned long)i);
+  }
+  // a retransmissão de um inválido continua inválida (não vira REPETIDO de um OK)
+  controle_ack_t ack = enviar(IP_A, PORTA, 2200, 14, mistos[3], 3);
+  CONFERIR(ack.status == CONTROLE_INVALIDO && mesmo_estado(&estado, &antes), "retransmissão de inválido: status %u",
+           ack.status);
+
+  // cabeçalho errado, ack, tamanho quebrado: descartados sem resposta
+  uint8_t datagrama[CONTROLE_UDP_MAX_DATAGRAMA + 4], resposta[CONTROLE_UDP_ACK_BYTES];
+  const controle_cmd_t cor[] = {{CONTROLE_CMD_COR, 1, 0, 0}};
+  uint16_t n = controle_udp_montar(20, cor, 1, datagrama);
+  struct {
+    const char *nome;
+    uint8_t byte, valor;
+    int16_t ajuste;
+  } ruins[] = {{"assinatura", 0, 'X', 0}, {"versão", 2, CONTROLE_UDP_VERSAO + 1, 0},
+               {"flag de ack", 3, CONTROLE_UDP_FLAG_ACK, 0}, {"tamanho", 0, 'S', -1}, {"curto", 0, 'S', -n + 4}};
+  for (size_t i = 0; i < sizeof(ruins) / sizeof(ruins[0]); ++i) {
+    controle_udp_montar(20, cor, 1, datagrama);
+    datagrama[ruins[i].byte] = ruins[i].valor;
+    CONFERIR(controle_udp_processar(datagrama, n + ruins[i].ajuste, IP_A, PORTA, 2300, &estado, resposta) == 0,
+             "datagrama com %s errado foi respondido", ruins[i].nome);
+  }
+  CONFERIR(controle_udp_processar(datagrama, CONTROLE_UDP_MAX_DATAGRAMA + 4, IP_A, PORTA, 2300, &estado, resposta) == 0,
+           "datagrama acima de CONTROLE_UDP_MAX_DATAGRAMA foi respondido");
+  CONFERIR(mesmo_estado(&estado, &antes), "datagrama descartado alterou o estado");
+}
+
+static void testar_clientes(void) {
+  const controle_cmd_t ping[] = {{CONTROLE_CMD_ESTADO, 0, 0, 0}};
+  const uint32_t t0 = 100000;          // longe dos instantes dos testes anteriores: tabela toda expirada
+
+  // enche a tabela com clientes vistos em t0, t0+1, ...; o próximo substitui o de t0
+  for (uint16_t c = 0; c < CONTROLE_UDP_CLIENTES; ++c)
+    enviar(IP_B, PORTA + c, t0 + c, 7, ping, 1);
+  enviar(IP_B, PORTA + CONTROLE_UDP_CLIENTES, t0 + CONTROLE_UDP_CLIENTES, 7, ping, 1);
+
+  controle_ack_t ack = enviar(IP_B, PORTA + 1, t0 + 10, 7, ping, 1);
+  CONFERIR(ack.status == CONTROLE_REPETIDO, "cliente ainda na tabela perdeu o seq (status %u)", ack.status);
+  ack = enviar(IP_B, PORTA, t0 + 11, 7, ping, 1);
+  CONFERIR(ack.status == CONTROLE_OK, "cliente substituído manteve o seq (status %u)", ack.status);
+  // ao voltar, ele tomou a vaga do visto há mais tempo (PORTA + 2), não a de um recente
+  ack = enviar(IP_B, PORTA + 1, t0 + 12, 7, ping, 1);
+  CONFERIR(ack.status == CONTROLE_REPETIDO, "substituição escolheu um cliente recente (status %u)", ack.status);
+  ack = enviar(IP_B, PORTA + 2, t0 + 13, 6, ping, 1);
+  CONFERIR(ack.status == CONTROLE_OK, "cliente mais antigo não foi substituído (status %u)", ack.status);
+
+  // mesmo IP, outra porta: cliente distinto (seq independente)
+  ack = enviar(IP_A, PORTA + 1, t0 + 14, 1, ping, 1);
+  CONFERIR(ack.status == CONTROLE_OK, "porta diferente compartilhou o seq (status %u)", ack.status);
+
+  // janela: no limite o seq ainda vale; passado dele, um cliente reiniciado recomeça a sequência
+  const uint32_t t1 = t0 + 1000;
+  enviar(IP_A, PORTA, t1, 500, ping, 1);
+  ack = enviar(IP_A, PORTA, t1 + CONTROLE_UDP_JANELA_MS, 1, ping, 1);
+  CONFERIR(ack.status == CONTROLE_ANTIGO, "seq esquecido antes do fim da janela (status %u)", ack.status);
+  ack = enviar(IP_A, PORTA, t1 + 2 * CONTROLE_UDP_JANELA_MS + 1, 1, ping, 1);
+  CONFERIR(ack.status == CONTROLE_OK, "seq lembrado depois da janela (status %u)", ack.status);
+}
+
+int main(void) {
+  testar_sequencia();
+  testar_invalidos();
+  testar_clientes();
+  printf("controle_udp: %d falhas\n", falhas);
+  return falhas ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+// Teste de ida e volta do espelho do OLED (lib/ssd1306_espelho.c)
+// Um cliente simulado segue o firmware quadro a quadro: pede com a versão que tem,
+// decodifica a resposta (completa ou XOR) e confere o resultado com o framebuffer.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssd1306_espelho.h"
+
+static uint8_t ram[1 + ESPELHO_BYTES];      // byte de controle 0x40 + quadro, como em ssd1306_init
+static ssd1306_t disp = {.width = WIDTH, .height = HEIGHT, .ram_buffer = ram};
+
+static uint8_t *quadro_atual(void) {
+  return ram + 1;
+}
+
+// alterações de conteúdo variadas: cada uma exercita literais, repetições ou ambos
+static void alterar(uint rodada) {
+  uint8_t *q = quadro_atual();
+  switch (rand() % 7) {
+    case 0:                                 // ruído: só literais
+      for (uint i = 0; i < ESPELHO_BYTES; ++i)
+        q[i] = rand();
+      break;
+    case 1:                                 // tela limpa ou cheia: só repetições
+      memset(q, rand() % 2 ? 0xFF : 0x00, ESPELHO_BYTES);
+      break;
+    case 2:                                 // poucos pixels (relógio, temperatura)
+      for (uint n = 1 + rand() % 8; n; --n)
+        q[rand() % ESPELHO_BYTES] ^= 1u << (rand() % 8);
+      break;
+    case 3: {                               // retângulo de um mesmo byte
+      uint ini = rand() % ESPELHO_BYTES, len = rand() % (ESPELHO_BYTES - ini + 1);
+      memset(q + ini, rand(), len);
+      break;
+    }
+    case 4:                                 // trechos curtos alternando repetição e ruído
+      for (uint i = 0; i < ESPELHO_BYTES;) {
+        uint len = 1 + rand() % 6;
+        uint8_t v = rand();
+        for (uint k = 0; k < len && i < ESPELHO_BYTES; ++k, ++i)
+          q[i] = rand() % 3 ? v : rand();
+      }
+      break;
+    case 5:                                 // literal de exatamente 128 bytes e vizinhos
+      for (uint i = 0; i < ESPELHO_BYTES; ++i)
+        q[i] = i % 129 < 128 + (int)(rodada % 3) - 1 ? (uint8_t)i : 0;
+      break;
+    default:                                // quadro inalterado: delta vazio
+      break;
+  }
+}
+
+int main(void) {
+  static uint8_t saida[ESPELHO_MAX_SAIDA];
+  static uint8_t cliente[ESPELHO_BYTES];
+  uint32_t versao_cliente = 0;
+  uint32_t deltas = 0, completos = 0, vazios = 0;
+  int falhas = 0;
+
+  ram[0] = 0x40;
+  srand(1306);
+  for (uint rodada = 0; rodada < 20000 && falhas < 10; ++rodada) {
+    alterar(rodada);
+    // de vez em quando o cliente chega sem quadro ou com uma versão velha
+    uint32_t pedida = rand() % 16 == 0 ? 0 : rand() % 16 == 0 ? versao_cliente - 1 : versao_cliente;
+
+    espelho_quadro_t info;
+    uint16_t n = ssd1306_espelho_codificar(&disp, pedida, saida, sizeof(saida), &info);
+    bool delta = info.base != 0;
+    if (delta && info.base != pedida) {
+      printf("rodada %u: delta contra a versão %u, cliente pediu %u\n", rodada, info.base, pedida);
+      falhas++;
+      continue;
+    }
+    if (!delta && n == 0) {
+      printf("rodada %u: quadro completo não coube em %u bytes\n", rodada, (unsigned)sizeof(saida));
+      falhas++;
+      continue;
+    }
+    if (!ssd1306_espelho_decodificar(saida, n, cliente, delta)) {
+      printf("rodada %u: RLE inválido (%u bytes, %s)\n", rodada, n, delta ? "delta" : "completo");
+      falhas++;
+    } else if (memcmp(cliente, quadro_atual(), ESPELHO_BYTES)) {
+      printf("rodada %u: quadro decodificado diverge do framebuffer (%s)\n", rodada, delta ? "delta" : "completo");
+      falhas++;
+    }
+    versao_cliente = info.versao;
+    delta ? (n ? deltas++ : vazios++) : completos++;
+  }
+
+  printf("espelho: %u completos, %u deltas, %u deltas vazios, %d falhas\n", completos, deltas, vazios, falhas);
+  return falhas ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+// Teste de carga do webserver: roda o simulador com host/scenarios/inundacao.txt e confere
+// o resultado do controle de admissão (lib/admissao_http.h) em summary.txt e http.log
+//  - o usuário normal (192.168.0.20) recebe 200 em todas as requisições
+//  - os PCBs de conexão ficam limitados às vagas da admissão e nenhum SYN fica sem PCB
+//  - nenhum pbuf vaza e o heap do lwIP não falha
+//  - a inundação de fato exercitou os 429, os RSTs e o fechamento de conexões ociosas
+// Uso: teste_inundacao <smart_home_sim> <roteiro> <pasta_saida>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "admissao_http.h"
+
+#define USUARIO_NORMAL "192.168.0.20"
+
+static int falhas = 0;
+
+#define CONFERIR(cond, ...)                                                    \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf(__VA_ARGS__);                                                     \
+      printf("\n");                                                            \
+      falhas++;                                                                \
+    }                                                                          \
+  } while (0)
+
+// valor de "chave=" em summary.txt; -1 se a chave não existe
+static long long contador(const char *pasta, const char *chave) {
+  char caminho[512], linha[256];
+  snprintf(caminho, sizeof(caminho), "%s/summary.txt", pasta);
+  FILE *f = fopen(caminho, "r");
+  if (!f)
+    return -1;
+  long long valor = -1;
+  size_t n = strlen(chave);
+  while (fgets(linha, sizeof(linha), f)) {
+    if (!strncmp(linha, chave, n) && linha[n] == '=') {
+      valor = atoll(linha + n + 1);
+      break;
+    }
+  }
+  fclose(f);
+  return valor;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    fprintf(stderr, "uso: %s <smart_home_sim> <roteiro> <pasta_saida>\n", argv[0]);
+    return 2;
+  }
+  const char *pasta = argv[3];
+  char comando[1024];
+  snprintf(comando, sizeof(comando), "\"%s\" -q -o \"%s\" \"%s\" > /dev/null", argv[1], pasta, argv[2]);
+  CONFERIR(system(comando) == 0, "simulador falhou: %s", comando);
+  CONFERIR(contador(pasta, "exit_code") == 0, "simulador terminou com exit_code=%lld", contador(pasta, "exit_code"));
+
+  // usuário normal: todas as respostas 200, nenhuma recusada, sem PCB ou com 429
+  char caminho[512], linha[512];
+  snprintf(caminho, sizeof(caminho), "%s/http.log", pasta);
+  FILE *log = fopen(caminho, "r");
+  CONFERIR(log, "sem %s", caminho);
+  int atendidas = 0, outras = 0;
+  while (log && fgets(linha, sizeof(linha), log)) {
+    if (!strstr(linha, " " USUARIO_NORMAL " "))
+      continue;
+    if (strstr(linha, "-> ok HTTP/1.1 200 OK")) {
+      atendidas++;
+    } else if (outras++ < 5) {
+      printf("usuário normal sem 200: %s", linha);
+    }
+  }
+  if (log)
+    fclose(log);
+  CONFERIR(outras == 0, "%d requisição(ões) de " USUARIO_NORMAL " sem 200 (de %d)", outras, atendidas + outras);
+  CONFERIR(atendidas >= 50, "só %d requisições de " USUARIO_NORMAL " atendidas", atendidas);
+
+  // PCBs: as vagas da admissão mais a conexão que está sendo avaliada no accept
+  long long pcb_max = contador(pasta, "tcp_pcb_max");
+  CONFERIR(pcb_max >= 1 && pcb_max <= ADMISSAO_MAX_EM_VOO + 1, "tcp_pcb_max=%lld, limite %d",
+           pcb_max, ADMISSAO_MAX_EM_VOO + 1);
+  CONFERIR(contador(pasta, "http_no_pcb") == 0, "http_no_pcb=%lld", contador(pasta, "http_no_pcb"));
+
+  CONFERIR(contador(pasta, "pbuf_leaks") == 0, "pbuf_leaks=%lld", contador(pasta, "pbuf_leaks"));
+  CONFERIR(contador(pasta, "lwip_mem_errors") == 0, "lwip_mem_errors=%lld", contador(pasta, "lwip_mem_errors"));
+
+  // o roteiro precisa continuar exercitando os três caminhos de recusa
+  CONFERIR(contador(pasta, "http_throttled") > 0, "nenhum 429");
+  CONFERIR(contador(pasta, "http_reset") > 0, "nenhum RST");
+  CONFERIR(contador(pasta, "http_idle_closed") > 0, "nenhuma conexão ociosa fechada");
+
+  printf("inundação: %d requisições de " USUARIO_NORMAL " com 200, tcp_pcb_max=%lld, %d falhas\n",
+         atendidas, pcb_max, falhas);
+  return falhas ? 1 : 0;
+}
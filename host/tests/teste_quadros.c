@@ -0,0 +1,84 @@
+// Teste dos quadros da matriz WS2812 calculados em tempo de compilação
+// Compara cada entrada de quadros_base e cor_grb com o desenho pixel a pixel
+// que o atualizar_matriz() original fazia a cada volta do laço principal.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ws2812_quadros.h"
+
+// mapeamento original dos LEDs de cada cômodo e da cruz central
+static const int comodos[4][4] = {
+    {24, 23, 15, 16},                  // quarto 1
+    {21, 20, 18, 19},                  // quarto 2
+    {5, 6, 4, 3},                      // cozinha
+    {8, 9, 1, 0}                       // banheiro
+};
+static const int cruz[] = {22, 17, 12, 7, 2, 14, 13, 11, 10};
+
+// componentes RGB de cada cor, como no switch original (VERMELHO..LILAS)
+static void rgb_original(int cor, uint8_t *r, uint8_t *g, uint8_t *b) {
+    *r = *g = *b = 0;
+    switch (cor) {
+        case 0: *r = 32; break;
+        case 1: *g = 32; break;
+        case 2: *b = 32; break;
+        case 3: *r = 32; *g = 32; break;
+        case 4: *g = 32; *b = 32; break;
+        case 5: *r = 32; *b = 32; break;
+    }
+}
+
+// réplica do atualizar_matriz() original
+static void desenhar_original(int comodo, int cor, bool led_ligado, bool emergencia,
+                              uint32_t pixels[MATRIZ_LEDS]) {
+    for (int i = 0; i < MATRIZ_LEDS; i++) pixels[i] = 0;
+    for (int i = 0; i < 9; i++)
+        pixels[cruz[i]] = ((uint32_t)(10) << 8) | ((uint32_t)(10) << 16) | (uint32_t)(10);
+    if (emergencia) {
+        for (int i = 0; i < 4; i++)
+            pixels[comodos[comodo][i]] = ((uint32_t)(32) << 8) | ((uint32_t)(0) << 16) | (uint32_t)(0);
+    } else if (led_ligado) {
+        uint8_t r, g, b;
+        rgb_original(cor, &r, &g, &b);
+        for (int i = 0; i < 4; i++)
+            pixels[comodos[comodo][i]] = ((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b);
+    }
+}
+
+int main(void) {
+    int falhas = 0;
+
+    for (int c = 0; c < NUM_CORES; c++) {
+        uint8_t r, g, b;
+        rgb_original(c, &r, &g, &b);
+        uint32_t esperado = ((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b);
+        if (cor_grb[c] != esperado) {
+            printf("cor_grb[%d] = %06x, esperado %06x\n", c, (unsigned)cor_grb[c], (unsigned)esperado);
+            falhas++;
+        }
+    }
+
+    int quadros = 0;
+    for (int comodo = 0; comodo < NUM_COMODOS; comodo++)
+        for (int cor = 0; cor < NUM_CORES; cor++)
+            for (int ligado = 0; ligado < 2; ligado++)
+                for (int emergencia = 0; emergencia < 2; emergencia++) {
+                    uint32_t esperado[MATRIZ_LEDS];
+                    desenhar_original(comodo, cor, ligado, emergencia, esperado);
+                    const uint32_t *quadro = quadros_base[comodo][cor][ligado][emergencia];
+                    for (int i = 0; i < MATRIZ_LEDS; i++) {
+                        if (quadro[i] != esperado[i]) {
+                            printf("quadros_base[%d][%d][%d][%d][%d] = %06x, esperado %06x\n",
+                                   comodo, cor, ligado, emergencia, i,
+                                   (unsigned)quadro[i], (unsigned)esperado[i]);
+                            falhas++;
+                        }
+                    }
+                    quadros++;
+                }
+
+    printf("%d quadros, %d cores conferidos: %d divergências\n", quadros, NUM_CORES, falhas);
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+// Teste do desenho de glifos ampliados da lib/ssd1306.c
+// Cada caractere desenhado em 2x e 3x (pelo cache ou, nos glifos largos demais para ele,
+// direto na tela) tem de ser o desenho em 1x com cada pixel virando um bloco scale x scale.
+// O desenho em 1x, por sua vez, é conferido bit a bit contra o bitmap da fonte, inclusive
+// nas fontes de duas páginas desenhadas fora do limite de página.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssd1306.h"
+
+// stub do barramento: o teste só lê o framebuffer
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)i2c;
+  (void)addr;
+  (void)src;
+  (void)nostop;
+  return (int)len;
+}
+
+#define LARGA_COLS 12                  // mais que SSD1306_GLYPH_MAX_COLS: não cabe no cache
+
+static uint8_t larga_bitmap[('9' - '0' + 1) * LARGA_COLS];
+static const uint8_t larga_prop[][2] = {
+  {0, 10}, {1, 11}, {2, 8}, {0, 12}, {3, 9}, {0, 7}, {1, 10}, {0, 11}, {2, 10}, {0, 12}
+};
+static const ssd1306_font_t fonte_larga = {larga_bitmap, NULL, LARGA_COLS, 1, 0, '0', '9'};
+static const ssd1306_font_t fonte_larga_prop = {larga_bitmap, larga_prop, LARGA_COLS, 1, 2, '0', '9'};
+
+static ssd1306_t ssd;
+static bool referencia[HEIGHT][WIDTH];
+
+static bool pixel(uint8_t x, uint8_t y) {
+  return ssd.ram_buffer[1 + x * ssd.pages + y / 8] >> (y % 8) & 1;
+}
+
+// pixel (i, j) do glifo de c direto do bitmap (colunas de pages bytes), como o desenho em 1x deve sair
+static bool pixel_fonte(const ssd1306_font_t *font, char c, uint8_t i, uint8_t j) {
+  uint16_t index = (c >= font->first && c <= font->last) ? c - font->first : 0;
+  uint8_t primeira = font->prop ? font->prop[index][0] : 0;
+  uint8_t largura = font->prop ? font->prop[index][1] : font->width;
+  if (i >= largura)
+    return false;                      // espaçamento
+  const uint8_t *coluna = font->bitmap + (index * font->width + primeira + i) * font->pages;
+  return coluna[j / 8] >> (j % 8) & 1;
+}
+
+static int conferir_1x(const char *nome, const ssd1306_font_t *font, char c) {
+  const uint8_t x = 3, y = 5;
+  ssd1306_fill(&ssd, true);
+  uint8_t avanco = ssd1306_draw_char_font(&ssd, font, 1, c, x, y);
+  int falhas = 0;
+  for (uint8_t j = 0; j < HEIGHT; ++j) {
+    for (uint8_t i = 0; i < WIDTH; ++i) {
+      bool dentro = i >= x && i < x + avanco && j >= y && j < y + 8 * font->pages;
+      bool esperado = dentro ? pixel_fonte(font, c, i - x, j - y) : true;
+      if (pixel(i, j) != esperado && falhas++ < 3)
+        printf("%s 1x '%c': pixel (%u, %u) = %d, esperado %d\n", nome, c, i, j, pixel(i, j), esperado);
+    }
+  }
+  return falhas != 0;
+}
+
+static int conferir(const char *nome, const ssd1306_font_t *font, uint8_t scale, char c) {
+  const uint8_t x = 3, y = 5;          // y fora do limite de página exercita o deslocamento
+
+  ssd1306_fill(&ssd, false);
+  uint8_t avanco_1x = ssd1306_draw_char_font(&ssd, font, 1, c, 0, 0);
+  for (uint8_t j = 0; j < 8 * font->pages; ++j)
+    for (uint8_t i = 0; i < avanco_1x; ++i)
+      referencia[j][i] = pixel(i, j);
+
+  int falhas = 0;
+  for (int vez = 0; vez < 2; ++vez) {  // a segunda vez vem do cache, quando o glifo cabe nele
+    ssd1306_fill(&ssd, true);          // pixels do glifo sobrescrevem; fora dele, preservados
+    uint8_t avanco = ssd1306_draw_char_font(&ssd, font, scale, c, x, y);
+    if (avanco != avanco_1x * scale) {
+      printf("%s %ux '%c': avanço %u, esperado %u\n", nome, scale, c, avanco, avanco_1x * scale);
+      return 1;
+    }
+    for (uint8_t j = 0; j < HEIGHT; ++j) {
+      for (uint8_t i = 0; i < WIDTH; ++i) {
+        bool dentro = i >= x && i < x + avanco && j >= y && j < y + 8 * font->pages * scale;
+        bool esperado = dentro ? referencia[(j - y) / scale][(i - x) / scale] : true;
+        if (pixel(i, j) != esperado && falhas++ < 3)
+          printf("%s %ux '%c' (vez %d): pixel (%u, %u) = %d, esperado %d\n",
+                 nome, scale, c, vez + 1, i, j, pixel(i, j), esperado);
+      }
+    }
+  }
+  return falhas != 0;
+}
+
+int main(void) {
+  srand(1306);
+  for (size_t i = 0; i < sizeof(larga_bitmap); ++i)
+    larga_bitmap[i] = rand();
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+
+  const struct {
+    const char *nome;
+    const ssd1306_font_t *font;
+  } fontes[] = {
+    {"8x8", &ssd1306_font_8x8},
+    {"8x8_prop", &ssd1306_font_8x8_prop},
+    {"larga", &fonte_larga},
+    {"larga_prop", &fonte_larga_prop},
+    {"12x16_digitos", &ssd1306_font_12x16_digitos},
+  };
+
+  int falhas = 0, glifos = 0;
+  for (size_t f = 0; f < sizeof(fontes) / sizeof(fontes[0]); ++f) {
+    for (char c = fontes[f].font->first; c <= fontes[f].font->last; ++c)
+      falhas += conferir_1x(fontes[f].nome, fontes[f].font, c);
+    for (uint8_t scale = 2; scale <= SSD1306_MAX_SCALE; ++scale) {
+      for (char c = fontes[f].font->first; c <= fontes[f].font->last; ++c) {
+        falhas += conferir(fontes[f].nome, fontes[f].font, scale, c);
+        glifos++;
+      }
+    }
+  }
+  printf("ssd1306: %d glifos ampliados conferidos, %d falhas\n", glifos, falhas);
+  return falhas ? 1 : 0;
+}
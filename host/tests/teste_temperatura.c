@@ -0,0 +1,55 @@
+// Teste exaustivo da conversão de temperatura em ponto fixo (lib/temperatura.c)
+// Para os 4096 códigos do ADC, temperatura_centi + temperatura_formatar tem de dar o mesmo
+// texto que o ler_temperatura() original em float com "%.1f", e a mesma decisão de emergência.
+//
+// Exceção conhecida: no código 3883 o float dá -1380.549927 (o valor exato é -1380.550003),
+// que o "%.1f" mostra como "-1380.5"; o ponto fixo dá "-1380.6", que é o arredondamento
+// correto. A diferença é erro do float, longe do limite de 40°C.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "temperatura.h"
+
+#define CODIGO_DIVERGENTE 3883
+
+// conversão original de main.c (float de precisão simples, como no M0+)
+static float ler_temperatura_original(uint16_t valor_bruto) {
+  const float fator_conversao = 3.3f / (1 << 12);
+  return 27.0f - ((valor_bruto * fator_conversao) - 0.706f) / 0.001721f;
+}
+
+int main(void) {
+  int falhas = 0, divergentes = 0;
+
+  for (uint16_t bruto = 0; bruto < 4096; ++bruto) {
+    float original = ler_temperatura_original(bruto);
+    char esperado[16];
+    snprintf(esperado, sizeof(esperado), "%.1f", original);
+
+    int32_t centi = temperatura_centi(bruto);
+    char texto[TEMPERATURA_MAX_TEXTO];
+    uint8_t n = temperatura_formatar(centi, texto);
+
+    if (n != strlen(texto)) {
+      printf("código %u: temperatura_formatar retornou %u para \"%s\"\n", bruto, n, texto);
+      falhas++;
+    }
+    if (strcmp(texto, esperado)) {
+      if (bruto == CODIGO_DIVERGENTE) {
+        divergentes++;
+      } else {
+        printf("código %u: \"%s\" (centi %ld), float dá \"%s\" (%.6f)\n",
+               bruto, texto, (long)centi, esperado, original);
+        falhas++;
+      }
+    }
+    if ((centi > TEMPERATURA_LIMITE_CENTI) != (original > 40.0f)) {
+      printf("código %u: emergência diverge (centi %ld, float %.6f)\n", bruto, (long)centi, original);
+      falhas++;
+    }
+  }
+
+  printf("temperatura: 4096 códigos, %d divergência(s) conhecida(s), %d falhas\n", divergentes, falhas);
+  return falhas ? 1 : 0;
+}
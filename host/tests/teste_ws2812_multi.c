@@ -0,0 +1,205 @@
+// Teste da lib/ws2812_multi.c sobre os shims de PIO e DMA do simulador
+//  - ws2812_transpor contra uma transposição ingênua, bit a bit, com entradas aleatórias
+//  - ws2812_multi_init recusa geometrias inválidas sem mexer no estado nem no hardware
+//  - sem espaço de programa ou sem canal DMA, nos dois modos, nada fica reservado
+//  - quando o PIO não comporta todas as fitas, as SMs, os canais DMA e o programa são liberados
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "ws2812_multi.h"
+#include "hardware/dma.h"
+
+// o que os shims de PIO e DMA esperam do núcleo do simulador
+static uint64_t relogio_us;
+uint64_t sim_now_us(void) { return relogio_us; }
+void sim_advance_us(uint64_t us) { relogio_us += us; }
+uint64_t time_us_64(void) { return relogio_us; }
+void busy_wait_until(absolute_time_t t) { if (t > relogio_us) relogio_us = t; }
+void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+FILE *sim_output_open(const char *name) { (void)name; return NULL; }
+void sim_finish(int code) {
+  fprintf(stderr, "shim encerrou o teste (código %d)\n", code);
+  exit(1);
+}
+
+static int falhas = 0;
+
+#define CONFERIR(cond, ...)                                                    \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: ", __FILE__, __LINE__);                                   \
+      printf(__VA_ARGS__);                                                     \
+      printf("\n");                                                            \
+      falhas++;                                                                \
+    }                                                                          \
+  } while (0)
+
+// referência: o plano p (0 = G7 ... 23 = B0) tem no bit s o bit 31-p da palavra da fita s
+static void transpor_ingenuo(const uint32_t *const fitas[], const uint16_t num_leds[], uint num_fitas,
+                             uint led, uint8_t planos[24]) {
+  for (uint p = 0; p < 24; ++p) {
+    uint8_t plano = 0;
+    for (uint s = 0; s < num_fitas; ++s) {
+      if (led < num_leds[s] && (fitas[s][led] >> (31 - p) & 1))
+        plano |= 1u << s;
+    }
+    planos[p] = plano;
+  }
+}
+
+static void testar_transposicao(void) {
+  static uint32_t dados[WS2812_MAX_FITAS][64];
+  srand(2812);
+  for (uint rodada = 0; rodada < 20000; ++rodada) {
+    uint num_fitas = 1 + rand() % WS2812_MAX_FITAS;
+    const uint32_t *fitas[WS2812_MAX_FITAS];
+    uint16_t num_leds[WS2812_MAX_FITAS];
+    for (uint f = 0; f < num_fitas; ++f) {
+      num_leds[f] = rand() % 65;
+      for (uint i = 0; i < num_leds[f]; ++i)
+        dados[f][i] = ((uint32_t)rand() << 16 ^ (uint32_t)rand()) << 8; // GRB << 8, byte baixo zerado
+      fitas[f] = dados[f];
+    }
+    uint led = rand() % 65;
+    uint32_t planos[6];
+    uint8_t esperado[24];
+    ws2812_transpor(fitas, num_leds, num_fitas, led, planos);
+    transpor_ingenuo(fitas, num_leds, num_fitas, led, esperado);
+    if (memcmp(planos, esperado, sizeof(esperado))) {
+      CONFERIR(0, "transposição diverge: rodada %u, %u fitas, led %u", rodada, num_fitas, led);
+      return;
+    }
+  }
+}
+
+static bool pio_livre(PIO pio) {
+  return pio->sm_claimed == 0 && pio->program_used == 0;
+}
+
+static bool dma_livre(void) {
+  int canal = dma_claim_unused_channel(false);
+  if (canal < 0)
+    return false;
+  dma_channel_unclaim(canal);
+  return canal == 0;
+}
+
+static void testar_geometrias_invalidas(void) {
+  static const ws2812_geometria_t valida = {
+    .modo = WS2812_MODO_SM_POR_FITA,
+    .num_fitas = 2,
+    .fitas = {{.pino = 7, .num_leds = 25}, {.pino = 8, .num_leds = 10}},
+    .num_trechos = 2,
+    .trechos = {{.comodo = 0, .fita = 1, .inicio = 0, .num_leds = 5},
+                {.comodo = 1, .fita = 1, .inicio = 5, .num_leds = 5}},
+  };
+  ws2812_geometria_t geo;
+
+  geo = valida;
+  geo.num_fitas = WS2812_MAX_FITAS + 1;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou %u fitas", geo.num_fitas);
+
+  geo = valida;
+  geo.num_fitas = 0;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou geometria sem fitas");
+
+  geo = valida;
+  geo.fitas[0].num_leds = WS2812_MAX_LEDS;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou mais de %d LEDs", WS2812_MAX_LEDS);
+
+  geo = valida;
+  geo.num_trechos = WS2812_MAX_TRECHOS + 1;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou %u trechos", geo.num_trechos);
+
+  geo = valida;
+  geo.trechos[1].fita = 2;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou trecho numa fita inexistente");
+
+  geo = valida;
+  geo.trechos[1].inicio = 6;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou trecho além do fim da fita");
+
+  geo = valida;
+  geo.modo = WS2812_MODO_PARALELO;
+  geo.fitas[1].pino = 9;
+  CONFERIR(!ws2812_multi_init(&geo, pio0), "aceitou pinos não consecutivos no modo paralelo");
+
+  CONFERIR(pio_livre(pio0) && dma_livre(), "geometria inválida reservou hardware");
+
+  // a geometria válida continua funcionando depois das recusas
+  geo = valida;
+  CONFERIR(ws2812_multi_init(&geo, pio0), "recusou geometria válida");
+  uint32_t *fita1 = ws2812_multi_fita(1);
+  ws2812_multi_pintar_comodo(1, 0x102030);
+  CONFERIR(fita1[4] == 0 && fita1[5] == 0x102030u << 8 && fita1[9] == 0x102030u << 8,
+           "pintar_comodo escreveu fora do trecho");
+}
+
+static void testar_recursos_esgotados(void) {
+  ws2812_geometria_t paralelo = {.modo = WS2812_MODO_PARALELO, .num_fitas = 3};
+  ws2812_geometria_t por_fita = {.modo = WS2812_MODO_SM_POR_FITA, .num_fitas = 3};
+  for (uint f = 0; f < 3; ++f) {
+    paralelo.fitas[f] = (ws2812_fita_t){.pino = 10 + f, .num_leds = 8};
+    por_fita.fitas[f] = paralelo.fitas[f];
+  }
+  const ws2812_geometria_t *geometrias[] = {&paralelo, &por_fita};
+  int canal_livre = dma_claim_unused_channel(false); // o PIO0 já tem as fitas do teste anterior
+  dma_channel_unclaim(canal_livre);
+
+  // memória de instruções quase cheia: não cabe nenhum dos dois programas
+  static const uint16_t instrucoes[31];
+  const pio_program_t ocupante = {instrucoes, 31, -1, 0};
+  uint offset = pio_add_program(pio1, &ocupante);
+  for (uint g = 0; g < 2; ++g) {
+    CONFERIR(!ws2812_multi_init(geometrias[g], pio1), "modo %u aceito sem espaço de programa", g);
+    int canal = dma_claim_unused_channel(false);
+    dma_channel_unclaim(canal);
+    CONFERIR(pio1->sm_claimed == 0 && pio1->program_used == 31 && canal == canal_livre,
+             "modo %u sem espaço de programa reservou hardware (SMs %#x, %u instruções)", g,
+             pio1->sm_claimed, pio1->program_used);
+  }
+  pio_remove_program(pio1, &ocupante, offset);
+
+  // todos os canais DMA ocupados
+  while (dma_claim_unused_channel(false) >= 0)
+    ;
+  for (uint g = 0; g < 2; ++g) {
+    CONFERIR(!ws2812_multi_init(geometrias[g], pio1), "modo %u aceito sem canal DMA", g);
+    CONFERIR(pio_livre(pio1), "modo %u sem canal DMA reservou SMs (%#x) ou programa (%u instruções)", g,
+             pio1->sm_claimed, pio1->program_used);
+  }
+  for (uint c = canal_livre; c < NUM_DMA_CHANNELS; ++c)
+    dma_channel_unclaim(c);
+}
+
+static void testar_liberacao(void) {
+  // 5 fitas, uma SM por fita: o PIO1 só tem 4 state machines
+  ws2812_geometria_t geo = {.modo = WS2812_MODO_SM_POR_FITA, .num_fitas = 5};
+  for (uint f = 0; f < geo.num_fitas; ++f)
+    geo.fitas[f] = (ws2812_fita_t){.pino = 10 + f, .num_leds = 8};
+
+  int canais_antes = dma_claim_unused_channel(false);
+  dma_channel_unclaim(canais_antes);
+  CONFERIR(!ws2812_multi_init(&geo, pio1), "aceitou 5 fitas num PIO de 4 state machines");
+  CONFERIR(pio_livre(pio1), "PIO1 ficou com SMs (%#x) ou programa (%u instruções) reservados",
+           pio1->sm_claimed, pio1->program_used);
+  int canal = dma_claim_unused_channel(false);
+  CONFERIR(canal == canais_antes, "canais DMA não foram devolvidos (primeiro livre: %d)", canal);
+  if (canal >= 0)
+    dma_channel_unclaim(canal);
+
+  geo.num_fitas = 4;
+  CONFERIR(ws2812_multi_init(&geo, pio1), "recusou 4 fitas depois da liberação");
+}
+
+int main(void) {
+  testar_transposicao();
+  testar_geometrias_invalidas();
+  testar_recursos_esgotados();
+  testar_liberacao();
+  printf("ws2812_multi: %d falhas\n", falhas);
+  return falhas ? 1 : 0;
+}
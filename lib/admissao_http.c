@@ -0,0 +1,92 @@
+#include "admissao_http.h"
+
+#define CREDITO_MAX ((uint32_t)ADMISSAO_RAJADA * ADMISSAO_INTERVALO_MS)
+
+// entradas com conexões abertas nunca são substituídas, então sempre sobra uma livre
+_Static_assert(ADMISSAO_CLIENTES > ADMISSAO_MAX_EM_VOO, "tabela de clientes menor que o limite de conexões");
+
+typedef struct {
+  bool usado;
+  uint32_t ip;
+  uint32_t credito_ms;                 // fichas disponíveis, em ms de intervalo
+  uint32_t visto_ms;                   // instante da última requisição
+  uint8_t em_voo;                      // conexões abertas deste IP
+} balde_t;
+
+static balde_t baldes[ADMISSAO_CLIENTES];
+static admissao_contadores_t contadores;
+
+// crédito do balde em agora_ms, sem passar do máximo
+static uint32_t credito(const balde_t *b, uint32_t agora_ms) {
+  uint32_t parado = agora_ms - b->visto_ms;
+  return parado >= CREDITO_MAX - b->credito_ms ? CREDITO_MAX : b->credito_ms + parado;
+}
+
+// Balde do IP; sem entrada, usa uma livre ou com o balde já cheio (nada se perde)
+// e, em último caso, a do cliente parado há mais tempo sem conexões abertas
+static balde_t *procurar(uint32_t ip, uint32_t agora_ms) {
+  balde_t *vaga = NULL;
+  bool vaga_cheia = false;
+  for (uint8_t i = 0; i < ADMISSAO_CLIENTES; ++i) {
+    balde_t *b = &baldes[i];
+    if (b->usado && b->ip == ip)
+      return b;
+    if (b->em_voo)
+      continue;
+    bool cheio = !b->usado || credito(b, agora_ms) == CREDITO_MAX;
+    if (!vaga || (!vaga_cheia && (cheio || (int32_t)(b->visto_ms - vaga->visto_ms) < 0))) {
+      vaga = b;
+      vaga_cheia = cheio;
+    }
+  }
+  if (!vaga_cheia)
+    contadores.substituicoes++;
+  vaga->usado = true;
+  vaga->ip = ip;
+  vaga->credito_ms = CREDITO_MAX;
+  vaga->visto_ms = agora_ms;
+  return vaga;
+}
+
+admissao_t admissao_verificar(uint32_t ip, uint32_t agora_ms, uint8_t *cliente) {
+  if (contadores.em_voo >= ADMISSAO_MAX_EM_VOO) {
+    contadores.lotadas++;
+    return ADMISSAO_LOTADA;
+  }
+  balde_t *b = procurar(ip, agora_ms);
+  if (b->em_voo >= ADMISSAO_MAX_POR_IP) {  // recusada antes de gastar ficha
+    contadores.lotadas++;
+    return ADMISSAO_LOTADA;
+  }
+  b->credito_ms = credito(b, agora_ms);
+  b->visto_ms = agora_ms;
+  admissao_t admissao;
+  if (b->credito_ms < ADMISSAO_INTERVALO_MS) {
+    contadores.limitadas++;
+    admissao = ADMISSAO_LIMITADA;
+  } else {
+    b->credito_ms -= ADMISSAO_INTERVALO_MS;
+    contadores.aceitas++;
+    admissao = ADMISSAO_ACEITA;
+  }
+  b->em_voo++;
+  if (++contadores.em_voo > contadores.pico_em_voo)
+    contadores.pico_em_voo = contadores.em_voo;
+  *cliente = (uint8_t)(b - baldes);
+  return admissao;
+}
+
+void admissao_encerrar(uint8_t cliente) {
+  if (cliente < ADMISSAO_CLIENTES && baldes[cliente].em_voo)
+    baldes[cliente].em_voo--;
+  if (contadores.em_voo)
+    contadores.em_voo--;
+}
+
+const admissao_contadores_t *admissao_contadores(void) {
+  return &contadores;
+}
+
+size_t admissao_memoria(void) {
+  return sizeof(baldes);
+}
@@ -0,0 +1,54 @@
+#ifndef ADMISSAO_HTTP_H
+#define ADMISSAO_HTTP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Controle de admissão do webserver, decidido no accept, antes de qualquer leitura.
+// Cada IP de origem tem um balde de fichas: ADMISSAO_RAJADA requisições seguidas e,
+// depois disso, uma a cada ADMISSAO_INTERVALO_MS. O balde é guardado como crédito em
+// ms (custo de uma requisição = ADMISSAO_INTERVALO_MS), que cresce com o tempo parado.
+// Acima da taxa a conexão recebe um 429 fixo; acima de ADMISSAO_MAX_EM_VOO conexões
+// abertas ao mesmo tempo, ou de ADMISSAO_MAX_POR_IP do mesmo IP, um RST, sem alocar nada.
+// Toda conexão aceita ocupa um PCB até terminar, inclusive as que esperam o 429, então
+// todas contam nos dois limites; o limite por IP impede que um cliente que conecta e não
+// envia nada (dentro ou acima da taxa) ocupe sozinho todas as vagas.
+
+#ifndef ADMISSAO_CLIENTES
+#define ADMISSAO_CLIENTES 8            // IPs acompanhados ao mesmo tempo
+#endif
+#ifndef ADMISSAO_RAJADA
+#define ADMISSAO_RAJADA 8              // requisições seguidas permitidas a um cliente parado
+#endif
+#ifndef ADMISSAO_INTERVALO_MS
+#define ADMISSAO_INTERVALO_MS 200      // taxa sustentada: 5 requisições/s por IP
+#endif
+#ifndef ADMISSAO_MAX_EM_VOO
+#define ADMISSAO_MAX_EM_VOO 4          // conexões aceitas ainda não respondidas (< MEMP_NUM_TCP_PCB)
+#endif
+#ifndef ADMISSAO_MAX_POR_IP
+#define ADMISSAO_MAX_POR_IP 2          // das ADMISSAO_MAX_EM_VOO, quantas um mesmo IP pode ocupar
+#endif
+
+typedef enum {
+  ADMISSAO_ACEITA,                     // processa normalmente; ocupa uma vaga até admissao_encerrar
+  ADMISSAO_LIMITADA,                   // cliente acima da taxa: responder 429 sem gerar a página; também ocupa vaga
+  ADMISSAO_LOTADA,                     // limite global ou do IP atingido: abortar a conexão (RST), sem vaga
+} admissao_t;
+
+typedef struct {
+  uint32_t aceitas;
+  uint32_t limitadas;                  // respostas 429
+  uint32_t lotadas;                    // conexões abortadas pelo limite global ou do IP
+  uint32_t substituicoes;              // clientes ativos esquecidos por falta de entradas
+  uint8_t em_voo, pico_em_voo;        // conexões abertas (aceitas e limitadas)
+} admissao_contadores_t;
+
+// Em ACEITA e LIMITADA, *cliente recebe a entrada do IP, a devolver em admissao_encerrar
+admissao_t admissao_verificar(uint32_t ip, uint32_t agora_ms, uint8_t *cliente);
+void admissao_encerrar(uint8_t cliente); // a conexão terminou (respondida, fechada ou com erro)
+const admissao_contadores_t *admissao_contadores(void);
+size_t admissao_memoria(void);         // bytes estáticos (tabela de clientes)
+
+#endif
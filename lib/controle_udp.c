@@ -0,0 +1,174 @@
+#include <string.h>
+#include "controle_udp.h"
+
+typedef struct {
+  bool usado;
+  uint32_t ip;
+  uint16_t porta;
+  uint32_t seq;                        // último seq processado
+  uint32_t visto_ms;                   // instante do último datagrama
+  uint8_t ack[CONTROLE_UDP_ACK_BYTES]; // resposta dada a seq, reenviada em retransmissões
+} cliente_t;
+
+static cliente_t clientes[CONTROLE_UDP_CLIENTES];
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+static uint32_t ler_u32(const uint8_t *p) {
+  return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void escrever_cabecalho(uint8_t *p, uint8_t flags, uint32_t seq) {
+  p[0] = 'S';
+  p[1] = 'H';
+  p[2] = CONTROLE_UDP_VERSAO;
+  p[3] = flags;
+  escrever_u32(p + 4, seq);
+}
+
+static uint16_t montar_ack(uint8_t *ack, uint32_t seq, uint8_t status, uint8_t aplicados, const controle_estado_t *estado) {
+  escrever_cabecalho(ack, CONTROLE_UDP_FLAG_ACK, seq);
+  uint8_t *c = ack + CONTROLE_UDP_CABECALHO;
+  c[0] = status;
+  c[1] = aplicados;
+  c[2] = estado->comodo;
+  c[3] = estado->cor;
+  c[4] = estado->ligado;
+  c[5] = estado->emergencia;
+  c[6] = c[7] = 0;
+  return CONTROLE_UDP_ACK_BYTES;
+}
+
+static bool valido(const uint8_t *c) {
+  switch (c[0]) {
+    case CONTROLE_CMD_ESTADO:
+    case CONTROLE_CMD_ALARME_OFF: return true;
+    case CONTROLE_CMD_COMODO: return c[1] < CONTROLE_UDP_COMODOS;
+    case CONTROLE_CMD_COR: return c[1] < CONTROLE_UDP_CORES;
+    case CONTROLE_CMD_LIGAR: return c[1] <= 1;
+    case CONTROLE_CMD_CENA: return c[1] < CONTROLE_UDP_COMODOS && c[2] < CONTROLE_UDP_CORES && c[3] <= 1;
+    default: return false;
+  }
+}
+
+static void aplicar(const uint8_t *c, controle_estado_t *estado) {
+  switch (c[0]) {
+    case CONTROLE_CMD_COMODO:
+      estado->comodo = c[1];
+      estado->ligado = true;
+      break;
+    case CONTROLE_CMD_COR: estado->cor = c[1]; break;
+    case CONTROLE_CMD_LIGAR: estado->ligado = c[1]; break;
+    case CONTROLE_CMD_ALARME_OFF: estado->emergencia = false; break;
+    case CONTROLE_CMD_CENA:
+      estado->comodo = c[1];
+      estado->cor = c[2];
+      estado->ligado = c[3];
+      break;
+  }
+}
+
+// Entrada do cliente (ip, porta); clientes em silêncio há mais de CONTROLE_UDP_JANELA_MS
+// são esquecidos, então um cliente reiniciado pode recomeçar a sequência
+static cliente_t *procurar(uint32_t ip, uint16_t porta, uint32_t agora_ms, bool *novo) {
+  cliente_t *vaga = NULL;              // entrada livre, expirada ou, em último caso, a mais antiga
+  bool vaga_ativa = true;
+  for (uint8_t i = 0; i < CONTROLE_UDP_CLIENTES; ++i) {
+    cliente_t *c = &clientes[i];
+    bool ativo = c->usado && agora_ms - c->visto_ms <= CONTROLE_UDP_JANELA_MS;
+    if (ativo && c->ip == ip && c->porta == porta) {
+      *novo = false;
+      return c;
+    }
+    if (!vaga || (vaga_ativa && (!ativo || (int32_t)(c->visto_ms - vaga->visto_ms) < 0))) {
+      vaga = c;
+      vaga_ativa = ativo;
+    }
+  }
+  *novo = true;
+  vaga->usado = true;
+  vaga->ip = ip;
+  vaga->porta = porta;
+  return vaga;
+}
+
+uint16_t controle_udp_processar(const uint8_t *dados, uint16_t tamanho, uint32_t ip, uint16_t porta,
+                                uint32_t agora_ms, controle_estado_t *estado, uint8_t *ack) {
+  if (tamanho < CONTROLE_UDP_CABECALHO || tamanho > CONTROLE_UDP_MAX_DATAGRAMA ||
+      (tamanho - CONTROLE_UDP_CABECALHO) % 4 || dados[0] != 'S' || dados[1] != 'H' ||
+      dados[2] != CONTROLE_UDP_VERSAO || (dados[3] & CONTROLE_UDP_FLAG_ACK))
+    return 0;                          // não é um datagrama de comandos: sem resposta
+
+  uint32_t seq = ler_u32(dados + 4);
+  uint8_t n = (tamanho - CONTROLE_UDP_CABECALHO) / 4;
+  const uint8_t *cmds = dados + CONTROLE_UDP_CABECALHO;
+  bool novo;
+  cliente_t *cliente = procurar(ip, porta, agora_ms, &novo);
+  cliente->visto_ms = agora_ms;
+
+  if (!novo && seq == cliente->seq) {  // retransmissão: mesmo ack, marcado como repetido
+    memcpy(ack, cliente->ack, CONTROLE_UDP_ACK_BYTES);
+    if (ack[CONTROLE_UDP_CABECALHO] == CONTROLE_OK)
+      ack[CONTROLE_UDP_CABECALHO] = CONTROLE_REPETIDO;
+    return CONTROLE_UDP_ACK_BYTES;
+  }
+  if (!novo && (int32_t)(seq - cliente->seq) < 0)
+    return montar_ack(ack, seq, CONTROLE_ANTIGO, 0, estado);
+
+  // valida o datagrama inteiro antes de aplicar: ou todos os comandos valem, ou nenhum
+  uint8_t status = CONTROLE_OK, aplicados = n;
+  for (uint8_t i = 0; i < n; ++i) {
+    if (!valido(cmds + 4 * i)) {
+      status = CONTROLE_INVALIDO;
+      aplicados = i;
+      break;
+    }
+  }
+  if (status == CONTROLE_OK) {
+    for (uint8_t i = 0; i < n; ++i)
+      aplicar(cmds + 4 * i, estado);
+  }
+
+  cliente->seq = seq;
+  montar_ack(cliente->ack, seq, status, aplicados, estado);
+  memcpy(ack, cliente->ack, CONTROLE_UDP_ACK_BYTES);
+  return CONTROLE_UDP_ACK_BYTES;
+}
+
+uint16_t controle_udp_montar(uint32_t seq, const controle_cmd_t *cmds, uint8_t n, uint8_t *saida) {
+  if (n > CONTROLE_UDP_MAX_CMDS)
+    n = CONTROLE_UDP_MAX_CMDS;
+  escrever_cabecalho(saida, 0, seq);
+  uint8_t *p = saida + CONTROLE_UDP_CABECALHO;
+  for (uint8_t i = 0; i < n; ++i, p += 4) {
+    p[0] = cmds[i].id;
+    p[1] = cmds[i].a;
+    p[2] = cmds[i].b;
+    p[3] = cmds[i].c;
+  }
+  return CONTROLE_UDP_CABECALHO + 4 * n;
+}
+
+bool controle_udp_ler_ack(const uint8_t *dados, uint16_t tamanho, controle_ack_t *ack) {
+  if (tamanho < CONTROLE_UDP_ACK_BYTES || dados[0] != 'S' || dados[1] != 'H' ||
+      dados[2] != CONTROLE_UDP_VERSAO || !(dados[3] & CONTROLE_UDP_FLAG_ACK))
+    return false;
+  const uint8_t *c = dados + CONTROLE_UDP_CABECALHO;
+  ack->seq = ler_u32(dados + 4);
+  ack->status = c[0];
+  ack->aplicados = c[1];
+  ack->estado.comodo = c[2];
+  ack->estado.cor = c[3];
+  ack->estado.ligado = c[4];
+  ack->estado.emergencia = c[5];
+  return true;
+}
+
+size_t controle_udp_memoria(void) {
+  return sizeof(clientes);
+}
@@ -0,0 +1,77 @@
+#ifndef CONTROLE_UDP_H
+#define CONTROLE_UDP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Protocolo binário de controle por UDP, para automação máquina a máquina.
+// Datagrama de comandos (inteiros em little-endian):
+//   0  'S' 'H'                assinatura
+//   2  versão (1)
+//   3  flags (bit 0 = ack)
+//   4  seq (u32)              número de sequência escolhido pelo cliente
+//   8  comandos de 4 bytes {id, a, b, c}, até CONTROLE_UDP_MAX_CMDS por datagrama
+// Ack (mesmo cabeçalho, flag de ack e o seq recebido):
+//   8  status, comandos aplicados, cômodo, cor, ligado, emergência, 2 bytes reservados
+//
+// Os comandos definem estado absoluto, e um datagrama é validado inteiro antes de ser
+// aplicado. O último seq de cada cliente (IP e porta) é lembrado: uma retransmissão
+// recebe de novo o ack original (com status REPETIDO) sem reaplicar nada, e um datagrama
+// atrasado, mais antigo que o último aplicado, é ignorado para não desfazer uma cena
+// mais nova.
+
+#define CONTROLE_UDP_PORTA 4210
+#define CONTROLE_UDP_VERSAO 1
+#define CONTROLE_UDP_FLAG_ACK 0x01
+#define CONTROLE_UDP_CABECALHO 8
+#define CONTROLE_UDP_MAX_CMDS 32
+#define CONTROLE_UDP_MAX_DATAGRAMA (CONTROLE_UDP_CABECALHO + 4 * CONTROLE_UDP_MAX_CMDS)
+#define CONTROLE_UDP_ACK_BYTES (CONTROLE_UDP_CABECALHO + 8)
+#define CONTROLE_UDP_CLIENTES 4        // clientes com seq lembrado ao mesmo tempo
+#define CONTROLE_UDP_JANELA_MS 30000   // silêncio após o qual o seq de um cliente é esquecido
+#define CONTROLE_UDP_COMODOS 4         // mesmos limites de Comodo e Cor em main.c
+#define CONTROLE_UDP_CORES 6
+
+typedef enum {
+  CONTROLE_CMD_ESTADO = 0x00,          // sem efeito: só pede o ack com o estado (ping)
+  CONTROLE_CMD_COMODO = 0x01,          // a = cômodo: seleciona e liga, como GET /roomN
+  CONTROLE_CMD_COR = 0x02,             // a = cor
+  CONTROLE_CMD_LIGAR = 0x03,           // a = 0 desliga, 1 liga
+  CONTROLE_CMD_ALARME_OFF = 0x04,      // desliga a emergência
+  CONTROLE_CMD_CENA = 0x05,            // a = cômodo, b = cor, c = ligado
+} controle_cmd_id_t;
+
+typedef enum {
+  CONTROLE_OK = 0,                     // todos os comandos aplicados
+  CONTROLE_REPETIDO = 1,               // seq já aplicado: ack original reenviado
+  CONTROLE_ANTIGO = 2,                 // seq anterior ao último aplicado: ignorado
+  CONTROLE_INVALIDO = 3,               // comando ou argumento inválido: nada aplicado
+} controle_status_t;
+
+typedef struct {
+  uint8_t id, a, b, c;
+} controle_cmd_t;
+
+typedef struct {
+  uint8_t comodo, cor;
+  bool ligado, emergencia;
+} controle_estado_t;
+
+typedef struct {
+  uint32_t seq;
+  uint8_t status;                      // controle_status_t
+  uint8_t aplicados;                   // comandos aplicados (ou índice do inválido)
+  controle_estado_t estado;            // estado do painel após o datagrama
+} controle_ack_t;
+
+// firmware: valida e aplica um datagrama sobre estado; retorna o tamanho do ack (0 = descartar)
+uint16_t controle_udp_processar(const uint8_t *dados, uint16_t tamanho, uint32_t ip, uint16_t porta,
+                                uint32_t agora_ms, controle_estado_t *estado, uint8_t *ack);
+
+// cliente
+uint16_t controle_udp_montar(uint32_t seq, const controle_cmd_t *cmds, uint8_t n, uint8_t *saida);
+bool controle_udp_ler_ack(const uint8_t *dados, uint16_t tamanho, controle_ack_t *ack);
+size_t controle_udp_memoria(void); // bytes estáticos (tabela de clientes)
+
+#endif
@@ -101,4 +101,167 @@ static uint8_t font[] = {
 0x00, 0x41, 0x41, 0x77, 0x3E, 0x08, 0x08, 0x00, // }
 0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01, 0x00  // ~
 
-};
\ No newline at end of file
+};
+
+// Fonte proporcional derivada de font[]: {primeira coluna, largura} de cada glifo,
+// sem as colunas vazias das bordas (o espaço usa 3 colunas)
+static const uint8_t font_prop[][2] = {
+{0, 3}, // espaço
+{3, 2}, // !
+{1, 5}, // "
+{0, 7}, // #
+{0, 7}, // $
+{0, 7}, // %
+{0, 7}, // &
+{1, 3}, // '
+{2, 4}, // (
+{2, 4}, // )
+{0, 8}, // *
+{1, 6}, // +
+{2, 3}, // ,
+{1, 6}, // -
+{3, 2}, // .
+{0, 7}, // /
+{0, 7}, // 0
+{1, 6}, // 1
+{0, 7}, // 2
+{0, 7}, // 3
+{0, 7}, // 4
+{0, 7}, // 5
+{0, 7}, // 6
+{0, 7}, // 7
+{0, 7}, // 8
+{0, 7}, // 9
+{3, 2}, // :
+{2, 3}, // ;
+{1, 5}, // <
+{1, 6}, // =
+{2, 5}, // >
+{1, 6}, // ?
+{0, 7}, // @
+{0, 7}, // A
+{0, 7}, // B
+{0, 7}, // C
+{0, 7}, // D
+{0, 7}, // E
+{0, 7}, // F
+{0, 7}, // G
+{0, 7}, // H
+{1, 6}, // I
+{0, 7}, // J
+{0, 7}, // K
+{0, 7}, // L
+{0, 7}, // M
+{0, 7}, // N
+{0, 7}, // O
+{0, 7}, // P
+{0, 7}, // Q
+{0, 7}, // R
+{0, 7}, // S
+{0, 8}, // T
+{0, 7}, // U
+{0, 7}, // V
+{0, 7}, // W
+{0, 7}, // X
+{0, 7}, // Y
+{0, 7}, // Z
+{2, 4}, // [
+{0, 7}, // "\"
+{2, 4}, // ]
+{0, 7}, // ^
+{0, 8}, // _
+{3, 3}, // `
+{0, 7}, // a
+{0, 7}, // b
+{0, 7}, // c
+{0, 7}, // d
+{0, 7}, // e
+{1, 6}, // f
+{0, 7}, // g
+{0, 7}, // h
+{2, 4}, // i
+{0, 7}, // j
+{0, 7}, // k
+{2, 4}, // l
+{0, 7}, // m
+{0, 7}, // n
+{0, 7}, // o
+{0, 7}, // p
+{0, 7}, // q
+{0, 7}, // r
+{0, 7}, // s
+{1, 6}, // t
+{0, 7}, // u
+{0, 7}, // v
+{0, 7}, // w
+{0, 7}, // x
+{0, 7}, // y
+{0, 7}, // z
+{1, 6}, // {
+{3, 2}, // |
+{1, 6}, // }
+{0, 7}  // ~
+};
+
+// Dígitos 12x16 para a leitura da temperatura, de ' ' a '9': 12 colunas de 2 páginas por
+// glifo, com o byte da página de cima primeiro (bit 0 no topo). Só o espaço, '-', '.' e os
+// dígitos têm desenho; os demais caracteres do intervalo ficam vazios, com largura 0
+static const uint8_t font_digitos[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // espaço
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ! (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // " (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // # (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // $ (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // % (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // & (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ' (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ( (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ) (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // * (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // + (vazio)
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // , (vazio)
+0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, // -
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // .
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // / (vazio)
+0x00, 0x00, 0xF8, 0x1F, 0xFC, 0x3F, 0x06, 0x60, 0x06, 0x60, 0x06, 0x60, 0x06, 0x60, 0x06, 0x60, 0x06, 0x60, 0xFC, 0x3F, 0xF8, 0x1F, 0x00, 0x00, // 0
+0x00, 0x00, 0x00, 0x00, 0x10, 0x60, 0x18, 0x60, 0x0C, 0x60, 0xFE, 0x7F, 0xFE, 0x7F, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, // 1
+0x00, 0x00, 0x08, 0x78, 0x0C, 0x7C, 0x06, 0x66, 0x06, 0x63, 0x06, 0x61, 0x86, 0x61, 0x86, 0x60, 0xC6, 0x60, 0x7C, 0x60, 0x38, 0x60, 0x00, 0x00, // 2
+0x00, 0x00, 0x08, 0x10, 0x0C, 0x30, 0x06, 0x60, 0x06, 0x60, 0x06, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xFC, 0x3F, 0x38, 0x1F, 0x00, 0x00, // 3
+0x00, 0x00, 0x80, 0x07, 0xC0, 0x07, 0x60, 0x06, 0x30, 0x06, 0x18, 0x06, 0x0C, 0x06, 0xFE, 0x7F, 0xFE, 0x7F, 0x00, 0x06, 0x00, 0x06, 0x00, 0x00, // 4
+0x00, 0x00, 0xFE, 0x10, 0xFE, 0x30, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0x86, 0x3F, 0x06, 0x1F, 0x00, 0x00, // 5
+0x00, 0x00, 0xF0, 0x1F, 0xF8, 0x3F, 0x8C, 0x61, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0xC6, 0x60, 0x80, 0x3F, 0x00, 0x1F, 0x00, 0x00, // 6
+0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x78, 0x06, 0x7E, 0x86, 0x07, 0xE6, 0x01, 0x76, 0x00, 0x1E, 0x00, 0x0E, 0x00, 0x00, 0x00, // 7
+0x00, 0x00, 0x38, 0x1E, 0x7C, 0x3F, 0xC6, 0x61, 0x86, 0x61, 0x86, 0x61, 0x86, 0x61, 0x86, 0x61, 0xC6, 0x61, 0x7C, 0x3F, 0x38, 0x1E, 0x00, 0x00, // 8
+0x00, 0x00, 0xF8, 0x00, 0xFC, 0x01, 0x06, 0x63, 0x06, 0x63, 0x06, 0x63, 0x06, 0x63, 0x06, 0x63, 0x86, 0x31, 0xFC, 0x1F, 0xF8, 0x0F, 0x00, 0x00  // 9
+};
+
+// {primeira coluna, largura} de cada glifo de font_digitos; os dígitos têm todos 10 colunas
+// para a leitura não mudar de largura a cada segundo
+static const uint8_t font_digitos_prop[][2] = {
+{0, 4}, // espaço
+{0, 0}, // ! (vazio)
+{0, 0}, // " (vazio)
+{0, 0}, // # (vazio)
+{0, 0}, // $ (vazio)
+{0, 0}, // % (vazio)
+{0, 0}, // & (vazio)
+{0, 0}, // ' (vazio)
+{0, 0}, // ( (vazio)
+{0, 0}, // ) (vazio)
+{0, 0}, // * (vazio)
+{0, 0}, // + (vazio)
+{0, 0}, // , (vazio)
+{2, 8}, // -
+{5, 2}, // .
+{0, 0}, // / (vazio)
+{1, 10}, // 0
+{1, 10}, // 1
+{1, 10}, // 2
+{1, 10}, // 3
+{1, 10}, // 4
+{1, 10}, // 5
+{1, 10}, // 6
+{1, 10}, // 7
+{1, 10}, // 8
+{1, 10}  // 9
+};
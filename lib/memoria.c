@@ -0,0 +1,128 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include "memoria.h"
+
+#if PICO_ON_DEVICE
+#include <malloc.h>
+
+// limites definidos pelo linker script do SDK (memmap_default.ld)
+extern uint32_t __StackBottom, __StackTop;       // pilha do núcleo 0 (SCRATCH_Y)
+extern uint32_t __StackOneBottom, __StackOneTop; // pilha do núcleo 1 (SCRATCH_X)
+extern char __data_start__, __bss_end__;         // .data + .bss na RAM principal
+extern char __end__, __StackLimit;               // heap: do fim do .bss ao fim da RAM
+#endif
+
+typedef struct {
+  const char *nome;
+  uint32_t bytes;
+} item_t;
+
+static item_t itens[MEMORIA_MAX_ITENS];
+static uint8_t num_itens = 0;
+static uint32_t marca[2];              // última marca d'água logada por núcleo
+
+#if PICO_ON_DEVICE
+static void pintar(uint32_t *de, uint32_t *ate) {
+  while (de < ate)
+    *de++ = MEMORIA_PADRAO;
+}
+
+// primeira palavra (a partir da base) que não tem mais o padrão
+static uint32_t usada(uint32_t *base, uint32_t *topo) {
+  while (base < topo && *base == MEMORIA_PADRAO)
+    ++base;
+  return (uint32_t)((char *)topo - (char *)base);
+}
+#endif
+
+// O núcleo 0 é pintado da base até um pouco abaixo do SP atual; o núcleo 1 ainda
+// não foi lançado, então a pilha dele é pintada inteira
+void memoria_pintar_pilhas(void) {
+#if PICO_ON_DEVICE
+  uint32_t sp;
+  __asm volatile ("mov %0, sp" : "=r" (sp));
+  pintar(&__StackBottom, (uint32_t *)((sp - MEMORIA_FOLGA) & ~3u));
+  pintar(&__StackOneBottom, &__StackOneTop);
+#endif
+}
+
+uint32_t memoria_pilha_tamanho(uint nucleo) {
+#if PICO_ON_DEVICE
+  if (nucleo == 0)
+    return (uint32_t)((char *)&__StackTop - (char *)&__StackBottom);
+  return (uint32_t)((char *)&__StackOneTop - (char *)&__StackOneBottom);
+#else
+  (void)nucleo;
+  return 0;                            // no host a pilha é a do processo
+#endif
+}
+
+uint32_t memoria_pilha_maxima(uint nucleo) {
+#if PICO_ON_DEVICE
+  if (nucleo == 0)
+    return usada(&__StackBottom, &__StackTop);
+  return usada(&__StackOneBottom, &__StackOneTop);
+#else
+  (void)nucleo;
+  return 0;
+#endif
+}
+
+void memoria_registrar(const char *nome, size_t bytes) {
+  if (num_itens < MEMORIA_MAX_ITENS)
+    itens[num_itens++] = (item_t){nome, (uint32_t)bytes};
+}
+
+// acrescenta uma linha formatada ao resumo, truncando no fim do buffer
+static size_t anexar(char *saida, size_t tamanho, size_t n, const char *formato, ...) {
+  if (n + 1 >= tamanho)
+    return n;
+  va_list args;
+  va_start(args, formato);
+  int escrito = vsnprintf(saida + n, tamanho - n, formato, args);
+  va_end(args);
+  if (escrito < 0)
+    return n;
+  return n + (size_t)escrito < tamanho ? n + (size_t)escrito : tamanho - 1;
+}
+
+size_t memoria_resumo(char *saida, size_t tamanho) {
+  uint32_t total = 0;
+  size_t n = anexar(saida, tamanho, 0, "RAM por subsistema (bytes):\n");
+  for (uint8_t i = 0; i < num_itens; ++i) {
+    n = anexar(saida, tamanho, n, "  %-28s %6lu\n", itens[i].nome, (unsigned long)itens[i].bytes);
+    total += itens[i].bytes;
+  }
+  n = anexar(saida, tamanho, n, "  %-28s %6lu\n", "total registrado", (unsigned long)total);
+#if PICO_ON_DEVICE
+  struct mallinfo heap = mallinfo();
+  n = anexar(saida, tamanho, n, "  %-28s %6lu\n", ".data + .bss", (unsigned long)(&__bss_end__ - &__data_start__));
+  n = anexar(saida, tamanho, n, "  %-28s %6lu (em uso %lu)\n", "heap livre para malloc",
+             (unsigned long)(&__StackLimit - &__end__), (unsigned long)heap.uordblks);
+#endif
+  for (uint nucleo = 0; nucleo < 2; ++nucleo) {
+    uint32_t tamanho_pilha = memoria_pilha_tamanho(nucleo);
+    if (tamanho_pilha) {
+      char nome[24];
+      snprintf(nome, sizeof(nome), "pilha do nucleo %u", nucleo);
+      marca[nucleo] = memoria_pilha_maxima(nucleo);
+      n = anexar(saida, tamanho, n, "  %-28s %6lu (marca d'água %lu)\n", nome, (unsigned long)tamanho_pilha,
+                 (unsigned long)marca[nucleo]);
+    }
+  }
+  return anexar(saida, tamanho, n, "\n");
+}
+
+bool memoria_verificar(void) {
+  bool subiu = false;
+  for (uint nucleo = 0; nucleo < 2; ++nucleo) {
+    uint32_t m = memoria_pilha_maxima(nucleo);
+    if (m > marca[nucleo]) {
+      printf("Pilha do núcleo %u: marca d'água %lu de %lu bytes\n\n", nucleo,
+             (unsigned long)m, (unsigned long)memoria_pilha_tamanho(nucleo));
+      marca[nucleo] = m;
+      subiu = true;
+    }
+  }
+  return subiu;
+}
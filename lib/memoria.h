@@ -0,0 +1,22 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include "pico/stdlib.h"
+
+// Orçamento de RAM: todos os buffers de vida longa são estáticos (aparecem no .bss)
+// e cada subsistema registra o seu tamanho para o resumo do relatório de boot.
+// As pilhas dos dois núcleos são pintadas com um padrão no início de main();
+// a marca d'água é a parte da pilha em que o padrão já foi sobrescrito.
+
+#define MEMORIA_MAX_ITENS 16           // subsistemas no resumo
+#define MEMORIA_PADRAO 0xA5A5A5A5u     // palavra de pintura das pilhas
+#define MEMORIA_FOLGA 64               // bytes abaixo do SP atual que não são pintados
+
+void memoria_pintar_pilhas(void);      // primeira chamada de main(): pinta a parte livre das pilhas
+uint32_t memoria_pilha_tamanho(uint nucleo); // bytes reservados para a pilha (0 = sem medição)
+uint32_t memoria_pilha_maxima(uint nucleo);  // marca d'água: maior uso desde a pintura
+void memoria_registrar(const char *nome, size_t bytes); // soma um subsistema ao resumo
+size_t memoria_resumo(char *saida, size_t tamanho); // escreve a tabela de RAM estática, heap e pilhas; retorna o tamanho
+bool memoria_verificar(void);          // loga as pilhas se a marca d'água subiu; retorna true nesse caso
+
+#endif
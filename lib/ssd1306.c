@@ -1,44 +1,60 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Framebuffers reservados em tempo de link: sem heap, o consumo aparece no .bss
+static uint8_t buffers[SSD1306_MAX_DISPLAYS][SSD1306_BUFFER_BYTES];
+static uint8_t displays = 0;
+
+// Retorna false se o display não cabe em SSD1306_BUFFER_BYTES ou se já há
+// SSD1306_MAX_DISPLAYS displays inicializados
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  if (width > WIDTH || height > HEIGHT || displays == SSD1306_MAX_DISPLAYS)
+    return false;
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->tx_buffer = buffers[displays++];
+  ssd->ram_buffer = ssd->tx_buffer + SSD1306_WINDOW_BYTES;
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+
+  // janela de escrita fixa (tela inteira), enviada na mesma transação dos pixels:
+  // cada comando leva o controle 0x80 (Co = 1) e o 0x40 de ram_buffer inicia o fluxo de dados
+  const uint8_t window[SSD1306_WINDOW_BYTES / 2] = {
+    SET_COL_ADDR, 0, ssd->width - 1,
+    SET_PAGE_ADDR, 0, ssd->pages - 1
+  };
+  for (uint8_t i = 0; i < sizeof(window); ++i) {
+    ssd->tx_buffer[2 * i] = 0x80;
+    ssd->tx_buffer[2 * i + 1] = window[i];
+  }
+  return true;
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t commands[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01
+  };
+  ssd1306_command_batch(ssd, commands, sizeof(commands));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
@@ -52,18 +68,33 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
+// Envia uma sequência de comandos (com seus argumentos) em uma única transação,
+// usando o byte de controle 0x00 (Co = 0): todos os bytes seguintes são comandos
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *commands, size_t len) {
+  uint8_t buffer[SSD1306_MAX_BATCH + 1];
+  buffer[0] = 0x00;
+  while (len) {
+    size_t n = len < SSD1306_MAX_BATCH ? len : SSD1306_MAX_BATCH;
+    memcpy(buffer + 1, commands, n);
+    i2c_write_blocking(
+      ssd->i2c_port,
+      ssd->address,
+      buffer,
+      n + 1,
+      false
+    );
+    commands += n;
+    len -= n;
+  }
+}
+
+// Janela de endereços e pixels em uma só transação (tx_buffer)
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
   i2c_write_blocking(
     ssd->i2c_port,
     ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
+    ssd->tx_buffer,
+    SSD1306_WINDOW_BYTES + ssd->bufsize,
     false
   );
 }
@@ -153,33 +184,166 @@ void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value
     ssd1306_pixel(ssd, x, y, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
+const ssd1306_font_t ssd1306_font_8x8 = {font, NULL, 8, 1, 0, ' ', '~'};
+const ssd1306_font_t ssd1306_font_8x8_prop = {font, font_prop, 8, 1, 1, ' ', '~'};
+const ssd1306_font_t ssd1306_font_12x16_digitos = {font_digitos, font_digitos_prop, 12, 2, 2, ' ', '9'};
 
-  // Verifica o caractere e calcula o índice correspondente na fonte
-  if (c >= ' ' && c <= '~') // Verifica se o caractere está na faixa ASCII válida
-  {
-    index = (c - ' ') * 8; // Calcula o índice baseado na posição do caractere na tabela ASCII
+// Glifo ampliado e já quebrado em páginas: scale bytes por coluna, prontos para ram_buffer
+typedef struct {
+  const ssd1306_font_t *font;
+  uint32_t last_use;                   // carimbo para a política LRU (0 = entrada livre)
+  char c;
+  uint8_t scale, cols;
+  uint8_t data[SSD1306_GLYPH_MAX_COLS * SSD1306_MAX_SCALE * SSD1306_MAX_SCALE];
+} ssd1306_glyph_t;
+
+static ssd1306_glyph_t glyph_cache[SSD1306_GLYPH_CACHE];
+static uint32_t glyph_clock = 0;
+static const uint8_t blank_column[SSD1306_FONT_MAX_PAGES] = {0};
+
+// Escreve uma coluna de pages bytes a partir da linha y (não precisa ser múltipla de 8),
+// preservando os pixels fora do glifo e recortando na borda da tela
+static inline void blit_column(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *src, uint8_t pages) {
+  if (x >= ssd->width)
+    return;
+  uint8_t *column = ssd->ram_buffer + 1 + (uint16_t)x * ssd->pages;
+  uint8_t page = y >> 3, shift = y & 7;
+  for (uint8_t p = 0; p < pages && page + p < ssd->pages; ++p) {
+    uint16_t bits = (uint16_t)src[p] << shift;
+    uint16_t mask = (uint16_t)0xFF << shift;
+    column[page + p] = (column[page + p] & ~mask) | bits;
+    if (shift && page + p + 1 < ssd->pages)
+      column[page + p + 1] = (column[page + p + 1] & ~(mask >> 8)) | (bits >> 8);
   }
-  else
-  {
-    // Caractere inválido, desenha um espaço (ou pode ser tratado de outra forma)
-    index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
+}
+
+// Primeira coluna (pages bytes cada) e largura do glifo de c na fonte (caracteres fora da fonte viram espaço)
+static const uint8_t *glyph_columns(const ssd1306_font_t *font, char c, uint8_t *width) {
+  uint16_t index = (c >= font->first && c <= font->last) ? c - font->first : 0;
+  const uint8_t *columns = font->bitmap + index * font->width * font->pages;
+  if (!font->prop) {
+    *width = font->width;
+    return columns;
   }
+  *width = font->prop[index][1];
+  return columns + font->prop[index][0] * font->pages;
+}
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+// Amplia uma coluna da fonte: cada bit vira scale bits, e cada página de entrada, scale bytes de página
+static inline void expand_column(const uint8_t *column, uint8_t pages, uint8_t scale, uint8_t *out) {
+  for (uint8_t page = 0; page < pages; ++page, out += scale) {
+    uint32_t bits = 0;
+    for (uint8_t b = 0; b < 8; ++b)
+      if (column[page] & (1 << b))
+        bits |= ((1u << scale) - 1) << (b * scale);
+    for (uint8_t p = 0; p < scale; ++p)
+      out[p] = bits >> (8 * p);
+  }
+}
+
+// Expande o glifo uma única vez: cada coluna é repetida scale vezes e cada bit vira scale bits.
+// Retorna NULL se o glifo (com o espaçamento e contando cada página como uma coluna de 8 pixels)
+// passa de SSD1306_GLYPH_MAX_COLS e não cabe no cache
+static const ssd1306_glyph_t *glyph_lookup(const ssd1306_font_t *font, uint8_t scale, char c) {
+  ssd1306_glyph_t *victim = &glyph_cache[0];
+  for (uint8_t i = 0; i < SSD1306_GLYPH_CACHE; ++i) {
+    ssd1306_glyph_t *g = &glyph_cache[i];
+    if (g->last_use && g->font == font && g->scale == scale && g->c == c) {
+      g->last_use = ++glyph_clock;
+      return g;
+    }
+    if (g->last_use < victim->last_use)
+      victim = g;
+  }
+
+  uint8_t width;
+  const uint8_t *columns = glyph_columns(font, c, &width);
+  uint16_t total = width + (font->prop ? font->spacing : 0);
+  if (total * font->pages > SSD1306_GLYPH_MAX_COLS)
+    return NULL;
+  uint8_t *out = victim->data;
+  uint8_t bytes = font->pages * scale;   // bytes de página por coluna ampliada
+  for (uint8_t i = 0; i < total; ++i) {
+    expand_column(i < width ? columns + i * font->pages : blank_column, font->pages, scale, out);
+    for (uint8_t r = 1; r < scale; ++r)
+      memcpy(out + r * bytes, out, bytes);
+    out += scale * bytes;
+  }
+  victim->font = font;
+  victim->scale = scale;
+  victim->c = c;
+  victim->cols = total * scale;
+  victim->last_use = ++glyph_clock;
+  return victim;
+}
+
+// Desenha c com a fonte e ampliação dadas; retorna o avanço horizontal em pixels
+uint8_t ssd1306_draw_char_font(ssd1306_t *ssd, const ssd1306_font_t *font, uint8_t scale, char c, uint8_t x, uint8_t y) {
+  uint8_t width;
+  const uint8_t *columns;
+  if (scale > 1) {
+    if (scale > SSD1306_MAX_SCALE)
+      scale = SSD1306_MAX_SCALE;
+    uint8_t bytes = font->pages * scale;
+    const ssd1306_glyph_t *g = glyph_lookup(font, scale, c);
+    if (g) {
+      for (uint8_t i = 0; i < g->cols; ++i)
+        blit_column(ssd, x + i, y, g->data + i * bytes, bytes);
+      return g->cols;
+    }
+    // glifo largo ou alto demais para o cache: amplia coluna a coluna direto na tela
+    columns = glyph_columns(font, c, &width);
+    uint8_t total = width + (font->prop ? font->spacing : 0);
+    uint8_t expanded[SSD1306_FONT_MAX_PAGES * SSD1306_MAX_SCALE];
+    for (uint8_t i = 0; i < total; ++i) {
+      expand_column(i < width ? columns + i * font->pages : blank_column, font->pages, scale, expanded);
+      for (uint8_t r = 0; r < scale; ++r)
+        blit_column(ssd, x + i * scale + r, y, expanded, bytes);
     }
+    return total * scale;
+  }
+
+  // 1x: as colunas da fonte já estão no formato de página, sem passar pelo cache
+  columns = glyph_columns(font, c, &width);
+  for (uint8_t i = 0; i < width; ++i)
+    blit_column(ssd, x + i, y, columns + i * font->pages, font->pages);
+  if (!font->prop)
+    return width;
+  for (uint8_t i = 0; i < font->spacing; ++i)
+    blit_column(ssd, x + width + i, y, blank_column, font->pages);
+  return width + font->spacing;
+}
+
+// Largura em pixels de str desenhada com a fonte e ampliação dadas
+uint8_t ssd1306_string_width(const ssd1306_font_t *font, uint8_t scale, const char *str) {
+  uint16_t total = 0;
+  uint8_t width;
+  if (scale > SSD1306_MAX_SCALE)
+    scale = SSD1306_MAX_SCALE;
+  while (*str) {
+    glyph_columns(font, *str++, &width);
+    total += (width + (font->prop ? font->spacing : 0)) * scale;
   }
+  return total > 255 ? 255 : total;
+}
+
+// Desenha str em uma única linha; retorna a coluna seguinte ao último glifo
+uint8_t ssd1306_draw_string_font(ssd1306_t *ssd, const ssd1306_font_t *font, uint8_t scale, const char *str, uint8_t x, uint8_t y) {
+  while (*str && x < ssd->width)
+    x += ssd1306_draw_char_font(ssd, font, scale, *str++, x, y);
+  return x;
+}
+
+// RAM estática da biblioteca: framebuffers e cache de glifos
+size_t ssd1306_ram_bytes(void) {
+  return sizeof(buffers) + sizeof(glyph_cache);
 }
 
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  ssd1306_draw_char_font(ssd, &ssd1306_font_8x8, 1, c, x, y);
+}
 // Função para desenhar uma string
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
 {
@@ -1,9 +1,22 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_WINDOW_BYTES 12        // COL_ADDR e PAGE_ADDR (6 comandos) com byte de controle 0x80
+#define SSD1306_MAX_BATCH 32           // comandos por transação em ssd1306_command_batch
+#define SSD1306_MAX_SCALE 3            // ampliação máxima dos glifos (1x, 2x, 3x)
+#define SSD1306_GLYPH_CACHE 8          // glifos ampliados mantidos no cache LRU
+#define SSD1306_GLYPH_MAX_COLS 9       // colunas de 8 pixels de um glifo no cache, incluindo o espaçamento (os maiores não usam cache)
+#define SSD1306_FONT_MAX_PAGES 2       // altura máxima dos glifos em páginas (16 pixels)
+#ifndef SSD1306_MAX_DISPLAYS
+#define SSD1306_MAX_DISPLAYS 1         // framebuffers reservados estaticamente (um por display)
+#endif
+#define SSD1306_BUFFER_BYTES (SSD1306_WINDOW_BYTES + WIDTH * HEIGHT / 8 + 1) // janela + 0x40 + pixels
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -30,13 +43,29 @@ typedef struct {
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
+  uint8_t *tx_buffer;                  // janela de endereços seguida de ram_buffer: uma transação por quadro
   size_t bufsize;
   uint8_t port_buffer[2];
 } ssd1306_t;
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+// Fonte em colunas de pages bytes (8 pixels cada, bit 0 no topo), como font[] e font_digitos em font.h
+typedef struct {
+  const uint8_t *bitmap;               // glifos de first a last, width colunas cada
+  const uint8_t (*prop)[2];            // NULL: largura fixa; senão {primeira coluna, largura} por glifo
+  uint8_t width;                       // colunas por glifo em bitmap
+  uint8_t pages;                       // bytes por coluna: altura do glifo em páginas (até SSD1306_FONT_MAX_PAGES)
+  uint8_t spacing;                     // colunas vazias após cada glifo proporcional
+  char first, last;
+} ssd1306_font_t;
+
+extern const ssd1306_font_t ssd1306_font_8x8;      // font[] original, largura fixa
+extern const ssd1306_font_t ssd1306_font_8x8_prop; // mesmos glifos, largura proporcional
+extern const ssd1306_font_t ssd1306_font_12x16_digitos; // espaço, '-', '.' e dígitos de 16 pixels de altura
+
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *commands, size_t len);
 void ssd1306_send_data(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
@@ -46,4 +75,10 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_char_font(ssd1306_t *ssd, const ssd1306_font_t *font, uint8_t scale, char c, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_string_font(ssd1306_t *ssd, const ssd1306_font_t *font, uint8_t scale, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_string_width(const ssd1306_font_t *font, uint8_t scale, const char *str);
+size_t ssd1306_ram_bytes(void);
+
+#endif
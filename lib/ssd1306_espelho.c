@@ -0,0 +1,101 @@
+#include <string.h>
+#include "ssd1306_espelho.h"
+
+static uint8_t referencia[ESPELHO_BYTES];   // último quadro servido, base dos deltas
+static uint32_t versao_referencia = 0;      // 0 = nenhum quadro servido ainda
+
+// codifica a ^ b (ou só a, se b for NULL); retorna 0 se não couber em cap
+static uint16_t rle(const uint8_t *a, const uint8_t *b, uint16_t n, uint8_t *saida, uint16_t cap) {
+  uint16_t o = 0, i = 0, literal = 0;
+  while (i < n) {
+    uint8_t v = b ? a[i] ^ b[i] : a[i];
+    uint16_t run = 1;
+    while (i + run < n && run < 130 && (b ? a[i + run] ^ b[i + run] : a[i + run]) == v)
+      run++;
+    if (run < 3) {                          // curto demais: entra no literal em andamento
+      i += run;
+      while (i - literal >= 128) {          // fecha blocos literais cheios
+        if (o + 129 > cap)
+          return 0;
+        saida[o++] = 127;
+        for (uint16_t k = 0; k < 128; ++k)
+          saida[o++] = b ? a[literal + k] ^ b[literal + k] : a[literal + k];
+        literal += 128;
+      }
+      continue;
+    }
+    if (literal < i) {                      // literal pendente antes da repetição
+      uint16_t len = i - literal;
+      if (o + 1 + len > cap)
+        return 0;
+      saida[o++] = len - 1;
+      for (uint16_t k = 0; k < len; ++k)
+        saida[o++] = b ? a[literal + k] ^ b[literal + k] : a[literal + k];
+    }
+    if (o + 2 > cap)
+      return 0;
+    saida[o++] = 0x80 + (run - 3);
+    saida[o++] = v;
+    i += run;
+    literal = i;
+  }
+  if (literal < n) {
+    uint16_t len = n - literal;
+    if (o + 1 + len > cap)
+      return 0;
+    saida[o++] = len - 1;
+    for (uint16_t k = 0; k < len; ++k)
+      saida[o++] = b ? a[literal + k] ^ b[literal + k] : a[literal + k];
+  }
+  return o;
+}
+
+// Codifica o quadro atual para um cliente que tem a versão "versao_cliente".
+// Se o cliente tem a referência, envia o XOR contra ela; senão, o quadro inteiro.
+// Só existe uma referência (memória limitada): clientes atrasados recebem o quadro completo.
+uint16_t ssd1306_espelho_codificar(const ssd1306_t *ssd, uint32_t versao_cliente, uint8_t *saida, uint16_t cap, espelho_quadro_t *info) {
+  const uint8_t *quadro = ssd->ram_buffer + 1;  // pula o byte de controle 0x40
+  bool mudou = versao_referencia == 0 || memcmp(quadro, referencia, ESPELHO_BYTES) != 0;
+  bool delta = versao_cliente != 0 && versao_cliente == versao_referencia;
+
+  if (delta) {
+    info->tamanho = mudou ? rle(quadro, referencia, ESPELHO_BYTES, saida, cap) : 0;
+    info->base = versao_referencia;
+  } else {
+    info->tamanho = rle(quadro, NULL, ESPELHO_BYTES, saida, cap);
+    info->base = 0;
+  }
+  if (mudou) {
+    memcpy(referencia, quadro, ESPELHO_BYTES);
+    versao_referencia++;
+  }
+  info->versao = versao_referencia;
+  return info->tamanho;
+}
+
+#if !PICO_ON_DEVICE
+// Reconstrói o quadro: com delta, aplica o XOR sobre o conteúdo atual de "quadro"
+// (lado do cliente; só entra nos builds de host, onde os testes o usam)
+bool ssd1306_espelho_decodificar(const uint8_t *dados, uint16_t tamanho, uint8_t *quadro, bool delta) {
+  uint16_t i = 0, pos = 0;
+  if (!delta)
+    memset(quadro, 0, ESPELHO_BYTES);
+  if (tamanho == 0)
+    return true;                            // delta vazio: nada mudou
+  while (i < tamanho) {
+    uint8_t c = dados[i++];
+    uint16_t len = c < 0x80 ? c + 1 : c - 0x80 + 3;
+    if (pos + len > ESPELHO_BYTES || i + (c < 0x80 ? len : 1) > tamanho)
+      return false;
+    for (uint16_t k = 0; k < len; ++k)
+      quadro[pos + k] ^= c < 0x80 ? dados[i + k] : dados[i];
+    i += c < 0x80 ? len : 1;
+    pos += len;
+  }
+  return pos == ESPELHO_BYTES;
+}
+#endif
+
+size_t ssd1306_espelho_memoria(void) {
+  return sizeof(referencia);
+}
@@ -0,0 +1,30 @@
+#ifndef SSD1306_ESPELHO_H
+#define SSD1306_ESPELHO_H
+
+#include "ssd1306.h"
+
+// Espelhamento do framebuffer do SSD1306 para suporte remoto.
+// O quadro (bytes de ram_buffer sem o byte de controle, na ordem do endereçamento
+// vertical: coluna x, página p -> x * 8 + p) é enviado comprimido em RLE, inteiro
+// ou como XOR contra o último quadro servido, identificado por um número de versão.
+//
+// RLE (estilo PackBits):
+//   0x00-0x7F: seguem c + 1 bytes literais
+//   0x80-0xFF: o próximo byte se repete c - 0x80 + 3 vezes
+
+#define ESPELHO_BYTES (WIDTH * HEIGHT / 8)
+#define ESPELHO_MAX_SAIDA (ESPELHO_BYTES + (ESPELHO_BYTES + 127) / 128) // pior caso: só literais
+
+typedef struct {
+  uint32_t versao;                     // versão do quadro codificado
+  uint32_t base;                       // versão de referência do delta (0 = quadro completo)
+  uint16_t tamanho;                    // bytes RLE gerados
+} espelho_quadro_t;
+
+uint16_t ssd1306_espelho_codificar(const ssd1306_t *ssd, uint32_t versao_cliente, uint8_t *saida, uint16_t cap, espelho_quadro_t *info);
+#if !PICO_ON_DEVICE
+bool ssd1306_espelho_decodificar(const uint8_t *dados, uint16_t tamanho, uint8_t *quadro, bool delta);
+#endif
+size_t ssd1306_espelho_memoria(void); // bytes estáticos (quadro de referência)
+
+#endif
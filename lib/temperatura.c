@@ -0,0 +1,34 @@
+#include "temperatura.h"
+
+// T = 27 - (bruto * 3,3 / 4096 - 0,706) / 0,001721 (datasheet do RP2040), reescrita
+// como 100 * T = A - B * bruto com A e B em Q12; as constantes são calculadas pelo
+// compilador e o resto é uma multiplicação e um deslocamento de 32 bits
+#define TEMPERATURA_Q 12
+static const int32_t temperatura_a = (int32_t)((27.0 + 0.706 / 0.001721) * 100 * (1 << TEMPERATURA_Q) + 0.5);
+static const int32_t temperatura_b = (int32_t)(3.3 / 4096 / 0.001721 * 100 * (1 << TEMPERATURA_Q) + 0.5);
+
+int32_t temperatura_centi(uint16_t bruto) {
+  return (temperatura_a - temperatura_b * (int32_t)(bruto & 0xFFF)) >> TEMPERATURA_Q; // >> arredonda para baixo (GCC)
+}
+
+// Uma casa decimal, arredondada a partir dos centésimos; o sinal vem de centi,
+// então -0,04°C vira "-0.0" como no printf
+uint8_t temperatura_formatar(int32_t centi, char *saida) {
+  char digitos[TEMPERATURA_MAX_TEXTO];
+  uint8_t n = 0, i = 0;
+  uint32_t decimos = centi < 0 ? ((uint32_t)-centi + 4) / 10 : ((uint32_t)centi + 5) / 10;
+  if (centi < 0)
+    saida[i++] = '-';
+  digitos[n++] = '0' + decimos % 10;   // casa decimal
+  decimos /= 10;
+  do {
+    digitos[n++] = '0' + decimos % 10;
+    decimos /= 10;
+  } while (decimos);
+  while (n > 1)
+    saida[i++] = digitos[--n];
+  saida[i++] = '.';
+  saida[i++] = digitos[0];
+  saida[i] = '\0';
+  return i;
+}
@@ -0,0 +1,16 @@
+#ifndef TEMPERATURA_H
+#define TEMPERATURA_H
+
+#include <stdint.h>
+
+// Sensor de temperatura interno do RP2040 em ponto fixo (o M0+ não tem FPU).
+// A temperatura é um inteiro em centésimos de grau, truncado para baixo, para que
+// o arredondamento a uma casa de temperatura_formatar seja o mesmo do "%.1f".
+
+#define TEMPERATURA_LIMITE_CENTI 4000  // 40,00°C: acima disso o painel entra em emergência
+#define TEMPERATURA_MAX_TEXTO 8        // "-1479.5" + terminador, pior caso do ADC de 12 bits
+
+int32_t temperatura_centi(uint16_t bruto);              // leitura de 12 bits do canal 4 -> centésimos de °C
+uint8_t temperatura_formatar(int32_t centi, char *saida); // "27.3"; retorna o número de caracteres
+
+#endif
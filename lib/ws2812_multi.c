@@ -0,0 +1,208 @@
+#include <string.h>
+#include "ws2812_multi.h"
+#include "hardware/dma.h"
+#include "generated/ws2812.pio.h"
+#include "ws2812_paralelo_pio.h"
+
+static const ws2812_geometria_t *geometria;
+static PIO pio_fitas;
+static uint sm_fita[WS2812_MAX_FITAS];
+static int dma_fita[WS2812_MAX_FITAS];
+static uint32_t *pixels_fita[WS2812_MAX_FITAS];
+static uint16_t leds_fita[WS2812_MAX_FITAS];
+static uint16_t maior_fita;
+static uint32_t pixels[WS2812_MAX_LEDS];               // palavras no formato da FIFO (GRB << 8)
+static uint32_t planos[WS2812_MAX_LEDS_POR_FITA * 6];  // 24 planos de 8 bits por LED, modo paralelo
+static uint64_t proximo_quadro_us;                      // fim do quadro em andamento + reset
+
+// devolve o que ws2812_multi_init já reservou quando faltam SMs ou canais DMA para todas as fitas
+static void liberar_recursos(PIO pio, const pio_program_t *programa, uint offset, uint maquinas) {
+  for (uint f = 0; f < maquinas; ++f) {
+    pio_sm_set_enabled(pio, sm_fita[f], false);
+    pio_sm_unclaim(pio, sm_fita[f]);
+    dma_channel_unclaim(dma_fita[f]);
+  }
+  pio_remove_program(pio, programa, offset);
+}
+
+bool ws2812_multi_init(const ws2812_geometria_t *geo, PIO pio) {
+  // valida a geometria inteira antes de tocar nos buffers estáticos ou reservar hardware
+  if (geo->num_fitas == 0 || geo->num_fitas > WS2812_MAX_FITAS || geo->num_trechos > WS2812_MAX_TRECHOS)
+    return false;
+  uint total = 0;
+  uint16_t maior = 0;
+  for (uint f = 0; f < geo->num_fitas; ++f) {
+    total += geo->fitas[f].num_leds;
+    if (geo->fitas[f].num_leds > maior)
+      maior = geo->fitas[f].num_leds;
+  }
+  if (total > WS2812_MAX_LEDS)
+    return false;
+  // cada trecho precisa caber na sua fita, senão pintar_comodo invade a fita seguinte
+  for (uint t = 0; t < geo->num_trechos; ++t) {
+    const ws2812_trecho_t *tr = &geo->trechos[t];
+    if (tr->fita >= geo->num_fitas || tr->inicio + tr->num_leds > geo->fitas[tr->fita].num_leds)
+      return false;
+  }
+  if (geo->modo == WS2812_MODO_PARALELO) {
+    // os pinos precisam ser consecutivos, na ordem das fitas
+    for (uint f = 1; f < geo->num_fitas; ++f) {
+      if (geo->fitas[f].pino != geo->fitas[0].pino + f)
+        return false;
+    }
+    if (maior > WS2812_MAX_LEDS_POR_FITA)
+      return false;
+  }
+
+  total = 0;
+  for (uint f = 0; f < geo->num_fitas; ++f) {
+    pixels_fita[f] = &pixels[total];
+    leds_fita[f] = geo->fitas[f].num_leds;
+    total += geo->fitas[f].num_leds;
+  }
+  maior_fita = maior;
+  memset(pixels, 0, sizeof(pixels));
+
+  if (geo->modo == WS2812_MODO_PARALELO) {
+    // SM e canal DMA são reservados antes do programa, que só entra quando tudo está garantido
+    if (!pio_can_add_program(pio, &ws2812_paralelo_program))
+      return false;
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+      return false;
+    int dma = dma_claim_unused_channel(false);
+    if (dma < 0) {
+      pio_sm_unclaim(pio, sm);
+      return false;
+    }
+    uint offset = pio_add_program(pio, &ws2812_paralelo_program);
+    ws2812_paralelo_program_init(pio, sm, offset, geo->fitas[0].pino, geo->num_fitas, WS2812_FREQ);
+    sm_fita[0] = sm;
+    dma_fita[0] = dma;
+    dma_channel_config c = dma_channel_get_default_config(dma_fita[0]);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_fita[0], &c, &pio->txf[sm], planos, 0, false);
+  } else {
+    if (!pio_can_add_program(pio, &ws2812_program))
+      return false;
+    uint offset = pio_add_program(pio, &ws2812_program);
+    for (uint f = 0; f < geo->num_fitas; ++f) {
+      int sm = pio_claim_unused_sm(pio, false);
+      int dma = sm < 0 ? -1 : dma_claim_unused_channel(false);
+      if (dma < 0) {
+        if (sm >= 0)
+          pio_sm_unclaim(pio, sm);
+        liberar_recursos(pio, &ws2812_program, offset, f);
+        return false;
+      }
+      ws2812_program_init(pio, sm, offset, geo->fitas[f].pino, WS2812_FREQ, false);
+      sm_fita[f] = sm;
+      dma_fita[f] = dma;
+      dma_channel_config c = dma_channel_get_default_config(dma_fita[f]);
+      channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+      channel_config_set_read_increment(&c, true);
+      channel_config_set_write_increment(&c, false);
+      channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+      dma_channel_configure(dma_fita[f], &c, &pio->txf[sm], pixels_fita[f], 0, false);
+    }
+  }
+  geometria = geo;
+  pio_fitas = pio;
+  proximo_quadro_us = time_us_64();
+  return true;
+}
+
+// buffer da fita no formato da FIFO (GRB << 8); só escreva depois de ws2812_multi_aguardar()
+uint32_t *ws2812_multi_fita(uint fita) {
+  return pixels_fita[fita];
+}
+
+void ws2812_multi_pintar_comodo(uint comodo, uint32_t grb) {
+  for (uint t = 0; t < geometria->num_trechos; ++t) {
+    const ws2812_trecho_t *tr = &geometria->trechos[t];
+    if (tr->comodo != comodo)
+      continue;
+    uint32_t *p = pixels_fita[tr->fita] + tr->inicio;
+    for (uint i = 0; i < tr->num_leds; ++i)
+      p[i] = grb << 8u;
+  }
+}
+
+// espera o DMA terminar e as fitas travarem o quadro anterior
+void ws2812_multi_aguardar(void) {
+  uint canais = geometria->modo == WS2812_MODO_PARALELO ? 1 : geometria->num_fitas;
+  for (uint f = 0; f < canais; ++f)
+    dma_channel_wait_for_finish_blocking(dma_fita[f]);
+  busy_wait_until(proximo_quadro_us);
+}
+
+void ws2812_multi_mostrar(void) {
+  ws2812_multi_aguardar();
+  if (geometria->modo == WS2812_MODO_PARALELO) {
+    const uint32_t *fitas[WS2812_MAX_FITAS];
+    for (uint f = 0; f < geometria->num_fitas; ++f)
+      fitas[f] = pixels_fita[f];
+    for (uint led = 0; led < maior_fita; ++led)
+      ws2812_transpor(fitas, leds_fita, geometria->num_fitas, led, &planos[led * 6]);
+    dma_channel_transfer_from_buffer_now(dma_fita[0], planos, maior_fita * 6);
+  } else {
+    for (uint f = 0; f < geometria->num_fitas; ++f)
+      dma_channel_transfer_from_buffer_now(dma_fita[f], pixels_fita[f], leds_fita[f]);
+  }
+  proximo_quadro_us = time_us_64() + ws2812_multi_tempo_quadro_us(geometria);
+}
+
+// modelo do tempo de quadro: as fitas transmitem em paralelo, então vale a mais longa,
+// mais o reset; no modo paralelo a transposição na CPU vem antes do DMA
+uint32_t ws2812_multi_tempo_quadro_us(const ws2812_geometria_t *geo) {
+  uint32_t maior = 0;
+  for (uint f = 0; f < geo->num_fitas; ++f) {
+    if (geo->fitas[f].num_leds > maior)
+      maior = geo->fitas[f].num_leds;
+  }
+  uint32_t us = maior * WS2812_US_POR_LED + WS2812_RESET_US;
+  if (geo->modo == WS2812_MODO_PARALELO)
+    us += (uint32_t)((uint64_t)maior * WS2812_CICLOS_TRANSPOSICAO * 1000000 / clock_get_hz(clk_sys));
+  return us;
+}
+
+size_t ws2812_multi_memoria(void) {
+  return sizeof(pixels) + sizeof(planos);
+}
+
+// Transposição 8x8 de bits (Hacker's Delight, transpose8rS32): a linha i de entrada é o
+// byte da fita 7-i, e a linha j de saída é o plano do bit 7-j, com o bit s vindo da fita s
+static inline void transpor8(uint32_t x, uint32_t y, uint8_t *saida) {
+  uint32_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+  saida[0] = x >> 24; saida[1] = x >> 16; saida[2] = x >> 8; saida[3] = x;
+  saida[4] = y >> 24; saida[5] = y >> 16; saida[6] = y >> 8; saida[7] = y;
+}
+
+// gera os 24 planos (G7..G0, R7..R0, B7..B0) do LED "led" de todas as fitas;
+// fitas mais curtas que "led" contribuem com zeros
+void ws2812_transpor(const uint32_t *const fitas[], const uint16_t num_leds[], uint num_fitas, uint led, uint32_t planos_led[6]) {
+  uint32_t palavra[8] = {0};
+  for (uint f = 0; f < num_fitas; ++f) {
+    if (led < num_leds[f])
+      palavra[f] = fitas[f][led];      // GRB << 8: G nos bits 31-24, R em 23-16, B em 15-8
+  }
+  uint8_t *saida = (uint8_t *)planos_led; // planos em ordem de byte, como a SM os consome
+  for (uint cor = 0; cor < 3; ++cor) {
+    uint desl = 24 - 8 * cor;
+    uint32_t x = ((palavra[7] >> desl & 0xFF) << 24) | ((palavra[6] >> desl & 0xFF) << 16) |
+                 ((palavra[5] >> desl & 0xFF) << 8) | (palavra[4] >> desl & 0xFF);
+    uint32_t y = ((palavra[3] >> desl & 0xFF) << 24) | ((palavra[2] >> desl & 0xFF) << 16) |
+                 ((palavra[1] >> desl & 0xFF) << 8) | (palavra[0] >> desl & 0xFF);
+    transpor8(x, y, saida + 8 * cor);
+  }
+}
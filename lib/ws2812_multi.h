@@ -0,0 +1,64 @@
+#ifndef WS2812_MULTI_H
+#define WS2812_MULTI_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Saída WS2812 para várias fitas: a matriz da placa e fitas de iluminação dos cômodos.
+// Cada fita é transmitida em paralelo com as outras, então o tempo de quadro depende
+// só da fita mais longa, e o envio é feito por DMA sem ocupar a CPU.
+
+#ifndef WS2812_MAX_FITAS
+#define WS2812_MAX_FITAS 8             // limite do modo paralelo (8 pinos adjacentes)
+#endif
+#ifndef WS2812_MAX_TRECHOS
+#define WS2812_MAX_TRECHOS 16
+#endif
+#ifndef WS2812_MAX_LEDS
+#define WS2812_MAX_LEDS 1024           // soma dos LEDs de todas as fitas (4 bytes por LED)
+#endif
+#ifndef WS2812_MAX_LEDS_POR_FITA
+#define WS2812_MAX_LEDS_POR_FITA 256   // comprimento máximo no modo paralelo (24 bytes por LED)
+#endif
+
+#define WS2812_FREQ 800000             // taxa de bits das fitas
+#define WS2812_US_POR_LED 30           // 24 bits a 800kHz
+#define WS2812_RESET_US 280            // tempo em nível baixo para travar o quadro (WS2812B V5)
+#define WS2812_CICLOS_TRANSPOSICAO 160 // estimativa de ciclos do M0+ por LED no modo paralelo
+
+typedef enum {
+  WS2812_MODO_SM_POR_FITA,             // uma state machine e um canal DMA por fita (até 4 fitas no PIO0)
+  WS2812_MODO_PARALELO                 // uma state machine para até 8 fitas em pinos adjacentes
+} ws2812_modo_t;
+
+typedef struct {
+  uint8_t pino;
+  uint16_t num_leds;
+} ws2812_fita_t;
+
+// faixa contínua de LEDs de uma fita que pertence a um cômodo
+typedef struct {
+  uint8_t comodo;
+  uint8_t fita;
+  uint16_t inicio;
+  uint16_t num_leds;
+} ws2812_trecho_t;
+
+typedef struct {
+  ws2812_modo_t modo;
+  uint8_t num_fitas;
+  ws2812_fita_t fitas[WS2812_MAX_FITAS];
+  uint8_t num_trechos;
+  ws2812_trecho_t trechos[WS2812_MAX_TRECHOS];
+} ws2812_geometria_t;
+
+bool ws2812_multi_init(const ws2812_geometria_t *geo, PIO pio);
+uint32_t *ws2812_multi_fita(uint fita);
+void ws2812_multi_pintar_comodo(uint comodo, uint32_t grb);
+void ws2812_multi_aguardar(void);
+void ws2812_multi_mostrar(void);
+uint32_t ws2812_multi_tempo_quadro_us(const ws2812_geometria_t *geo);
+size_t ws2812_multi_memoria(void);    // bytes estáticos (pixels e planos do modo paralelo)
+void ws2812_transpor(const uint32_t *const fitas[], const uint16_t num_leds[], uint num_fitas, uint led, uint32_t planos[6]);
+
+#endif
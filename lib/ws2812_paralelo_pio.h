@@ -0,0 +1,73 @@
+// Programa PIO ws2812_paralelo, montado à mão (não é saída do pioasm)
+// Até 8 fitas em pinos adjacentes, alimentadas por um buffer transposto em planos de bits:
+// cada byte é um plano (bit s = bit da fita s) e cada palavra de 32 bits carrega 4 planos.
+//
+//   .program ws2812_paralelo
+//   .define public T1 3
+//   .define public T2 3
+//   .define public T3 4
+//   .wrap_target
+//       out x, 8                           ; próximo plano: um bit de cada fita
+//       mov pins, !null         [T1 - 1]   ; todas as linhas em nível alto
+//       mov pins, x             [T2 - 1]   ; fitas com bit 0 voltam para nível baixo
+//       mov pins, null          [T3 - 2]   ; fim do bit em nível baixo
+//   .wrap
+//
+// Ao mudar o programa acima, atualize as palavras de instrução e o wrap abaixo.
+
+#ifndef WS2812_PARALELO_PIO_H
+#define WS2812_PARALELO_PIO_H
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+#define ws2812_paralelo_wrap_target 0
+#define ws2812_paralelo_wrap 3
+#define ws2812_paralelo_pio_version 0
+
+#define ws2812_paralelo_T1 3
+#define ws2812_paralelo_T2 3
+#define ws2812_paralelo_T3 4
+
+static const uint16_t ws2812_paralelo_program_instructions[] = {
+            //     .wrap_target
+    0x6028, //  0: out    x, 8
+    0xa20b, //  1: mov    pins, !null            [2]
+    0xa201, //  2: mov    pins, x                [2]
+    0xa203, //  3: mov    pins, null             [2]
+            //     .wrap
+};
+
+static const struct pio_program ws2812_paralelo_program = {
+    .instructions = ws2812_paralelo_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = ws2812_paralelo_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config ws2812_paralelo_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + ws2812_paralelo_wrap_target, offset + ws2812_paralelo_wrap);
+    return c;
+}
+
+static inline void ws2812_paralelo_program_init(PIO pio, uint sm, uint offset, uint pin_base, uint pin_count, float freq) {
+    for (uint i = pin_base; i < pin_base + pin_count; i++) {
+        pio_gpio_init(pio, i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, pin_base, pin_count, true);
+    pio_sm_config c = ws2812_paralelo_program_get_default_config(offset);
+    sm_config_set_out_pins(&c, pin_base, pin_count);
+    sm_config_set_out_shift(&c, true, true, 32); // planos saem do byte menos significativo
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    int cycles_per_bit = ws2812_paralelo_T1 + ws2812_paralelo_T2 + ws2812_paralelo_T3;
+    float div = clock_get_hz(clk_sys) / (freq * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
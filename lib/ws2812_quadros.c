@@ -0,0 +1,38 @@
+#include "ws2812_quadros.h"
+
+// cômodo aceso (vermelho em emergência) por cima da cruz branca
+#define PIXEL(r, c, l, e, i)                                               \
+  ((((MASCARA_COMODO(r) >> (i)) & 1) && ((e) || (l)))                      \
+       ? ((e) ? GRB_EMERGENCIA : COR_GRB(c))                               \
+       : (((MASCARA_CRUZ >> (i)) & 1) ? GRB_BRANCO_CRUZ : 0))
+
+#define QUADRO(r, c, l, e) {                                                                   \
+  PIXEL(r, c, l, e, 0), PIXEL(r, c, l, e, 1), PIXEL(r, c, l, e, 2), PIXEL(r, c, l, e, 3),     \
+  PIXEL(r, c, l, e, 4), PIXEL(r, c, l, e, 5), PIXEL(r, c, l, e, 6), PIXEL(r, c, l, e, 7),     \
+  PIXEL(r, c, l, e, 8), PIXEL(r, c, l, e, 9), PIXEL(r, c, l, e, 10), PIXEL(r, c, l, e, 11),   \
+  PIXEL(r, c, l, e, 12), PIXEL(r, c, l, e, 13), PIXEL(r, c, l, e, 14), PIXEL(r, c, l, e, 15), \
+  PIXEL(r, c, l, e, 16), PIXEL(r, c, l, e, 17), PIXEL(r, c, l, e, 18), PIXEL(r, c, l, e, 19), \
+  PIXEL(r, c, l, e, 20), PIXEL(r, c, l, e, 21), PIXEL(r, c, l, e, 22), PIXEL(r, c, l, e, 23), \
+  PIXEL(r, c, l, e, 24) }
+
+#define QUADROS_EMERGENCIA(r, c, l) { QUADRO(r, c, l, 0), QUADRO(r, c, l, 1) }
+#define QUADROS_LIGADO(r, c) { QUADROS_EMERGENCIA(r, c, 0), QUADROS_EMERGENCIA(r, c, 1) }
+#define QUADROS_COMODO(r) { QUADROS_LIGADO(r, 0), QUADROS_LIGADO(r, 1), QUADROS_LIGADO(r, 2), \
+                            QUADROS_LIGADO(r, 3), QUADROS_LIGADO(r, 4), QUADROS_LIGADO(r, 5) }
+
+// cor de cada posição do enum Cor (LED RGB e matriz)
+const uint32_t cor_grb[NUM_CORES] = {
+  COR_GRB(0), COR_GRB(1), COR_GRB(2), COR_GRB(3), COR_GRB(4), COR_GRB(5)
+};
+
+// quadros_base[comodo][cor][ligado][emergencia][led], residente na flash (~9,6KB)
+const uint32_t quadros_base[NUM_COMODOS][NUM_CORES][2][2][MATRIZ_LEDS] = {
+  QUADROS_COMODO(0), QUADROS_COMODO(1), QUADROS_COMODO(2), QUADROS_COMODO(3)
+};
+
+// conferências em tempo de compilação contra o desenho original
+_Static_assert(PIXEL(0, 0, 1, 0, 24) == GRB(32, 0, 0), "quarto 1 vermelho");
+_Static_assert(PIXEL(3, 4, 1, 0, 0) == GRB(0, 32, 32), "banheiro ciano");
+_Static_assert(PIXEL(2, 5, 0, 1, 5) == GRB_EMERGENCIA, "emergência sobrepõe LEDs desligados");
+_Static_assert(PIXEL(1, 2, 0, 0, 21) == 0, "cômodo desligado fica apagado");
+_Static_assert(PIXEL(1, 2, 1, 1, 12) == GRB_BRANCO_CRUZ, "cruz sempre branca");
@@ -0,0 +1,41 @@
+// Tabelas da matriz WS2812 5x5 calculadas em tempo de compilação
+// Cada palavra está no formato GRB (G nos bits 23-16, R em 15-8, B em 7-0),
+// pronta para ser deslocada 8 bits e escrita na FIFO do PIO.
+// Os quadros base (ws2812_quadros.c) cobrem todas as combinações (cômodo, cor, ligado,
+// emergência), então desenhar a matriz é só indexar a tabela e copiar 25 palavras.
+
+#ifndef WS2812_QUADROS_H
+#define WS2812_QUADROS_H
+
+#include <stdint.h>
+
+#define MATRIZ_LEDS 25                 // LEDs da matriz 5x5
+#define NUM_CORES 6                    // VERMELHO, VERDE, AZUL, AMARELO, CIANO, LILAS (ordem do enum Cor)
+#define NUM_COMODOS 4                  // QUARTO_1, QUARTO_2, COZINHA, BANHEIRO (ordem do enum Comodo)
+
+#define GRB(r, g, b) (((uint32_t)(g) << 16) | ((uint32_t)(r) << 8) | (uint32_t)(b))
+#define GRB_BRANCO_CRUZ GRB(10, 10, 10)
+#define GRB_EMERGENCIA GRB(32, 0, 0)
+
+// cor de cada posição do enum Cor, com intensidade 32
+#define COR_GRB(c) ((c) == 0 ? GRB(32, 0, 0) :  \
+                    (c) == 1 ? GRB(0, 32, 0) :  \
+                    (c) == 2 ? GRB(0, 0, 32) :  \
+                    (c) == 3 ? GRB(32, 32, 0) : \
+                    (c) == 4 ? GRB(0, 32, 32) : GRB(32, 0, 32))
+
+#define BIT(i) (1ul << (i))
+
+// LEDs da cruz central: 22, 17, 12, 7, 2, 14, 13, 11, 10
+#define MASCARA_CRUZ (BIT(22) | BIT(17) | BIT(12) | BIT(7) | BIT(2) | BIT(14) | BIT(13) | BIT(11) | BIT(10))
+
+// LEDs de cada cômodo (4 por cômodo, um em cada canto)
+#define MASCARA_COMODO(r) ((r) == 0 ? (BIT(24) | BIT(23) | BIT(15) | BIT(16)) : \
+                           (r) == 1 ? (BIT(21) | BIT(20) | BIT(18) | BIT(19)) : \
+                           (r) == 2 ? (BIT(5) | BIT(6) | BIT(4) | BIT(3)) :     \
+                                      (BIT(8) | BIT(9) | BIT(1) | BIT(0)))
+
+extern const uint32_t cor_grb[NUM_CORES];  // cor de cada posição do enum Cor (LED RGB e matriz)
+extern const uint32_t quadros_base[NUM_COMODOS][NUM_CORES][2][2][MATRIZ_LEDS]; // [comodo][cor][ligado][emergencia][led]
+
+#endif
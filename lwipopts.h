@@ -7,11 +7,11 @@
 #define LWIP_TCP 1
 #define LWIP_UDP 1
 #define MEM_ALIGNMENT 4
-#define MEM_SIZE 3072 // Reduzido para liberar SRAM
+#define MEM_SIZE 10240 // Cópias de tcp_write até o ACK: ~4 páginas de ~2,1KB em voo (pico em lwip_stats.mem.max)
 #define MEMP_NUM_PBUF 12 // Reduzido para economizar memória
 #define PBUF_POOL_SIZE 12 // Reduzido para economizar memória
 #define MEMP_NUM_UDP_PCB 4
-#define MEMP_NUM_TCP_PCB 4
+#define MEMP_NUM_TCP_PCB 6 // Clientes simultâneos, incluindo conexões em TIME_WAIT
 #define MEMP_NUM_TCP_SEG 24 // Suficiente para TCP_SND_QUEUELEN
 #define LWIP_IPV4 1
 #define LWIP_ICMP 1
@@ -23,5 +23,7 @@
 #define TCP_WND 3072 // Ajustado para HTML ~600 bytes
 #define TCP_SND_BUF 3072 // Ajustado para HTML ~600 bytes
 #define LWIP_NETIF_HOSTNAME 1
+#define LWIP_STATS 1 // Marca d'água do heap para o resumo de memória
+#define MEM_STATS 1
 
 #endif
\ No newline at end of file
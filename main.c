@@ -6,20 +6,42 @@
 #include <string.h>                    // manipulação de strings 
 #include <stdlib.h>                    // funções padrão 
 #include "pico/stdlib.h"               // funções básicas do Pico SDK 
+#include "pico/stdio_usb.h"            // estado da porta serial USB (CDC)
 #include "hardware/gpio.h"             // controle de GPIOs 
 #include "hardware/i2c.h"              // comunicação I2C para o display OLED 
 #include "hardware/adc.h"              // leitura do ADC para sensor de temperatura interno
 #include "pico/cyw43_arch.h"           // suporte ao módulo Wi-Fi CYW43439 
 #include "lwip/pbuf.h"                 // buffers de dados para comunicação TCP 
 #include "lwip/tcp.h"                  // protocolo TCP para implementar o webserver
+#include "lwip/udp.h"                  // protocolo UDP para o controle binário
 #include "lwip/netif.h"                // interface de rede para obter endereço IP
-#include "generated/ws2812.pio.h"      // controlar matriz WS2812 via PIO
+#include "lwip/dhcp.h"                 // parada do DHCP quando o IP é fixo
+#include "lwip/stats.h"                // pico de uso do heap do lwIP
 #include "lib/ssd1306.h"               // biblioteca para display OLED SSD1306 
+#include "lib/ssd1306_espelho.h"       // espelhamento comprimido do framebuffer do OLED
+#include "lib/ws2812_quadros.h"        // cores e quadros da matriz pré-calculados em tempo de compilação
+#include "lib/ws2812_multi.h"          // saída WS2812 para várias fitas via PIO + DMA
+#include "lib/controle_udp.h"          // protocolo binário de controle por UDP
+#include "lib/memoria.h"               // pintura das pilhas e resumo do uso de RAM
+#include "lib/temperatura.h"           // conversão do sensor interno em ponto fixo
+#include "lib/admissao_http.h"         // limite de taxa por cliente e de conexões simultâneas
 
 // credenciais Wi-Fi
 #define WIFI_SSID "Apartamento 01"     // ssid (nome) da rede Wi-Fi para conexão
 #define WIFI_PASSWORD "12345678"       // senha da rede Wi-Fi para autenticação
 
+// conexão Wi-Fi assíncrona
+#define WIFI_IP_FIXO 0                 // 1 = usa o IP abaixo em vez do DHCP (reassociação mais rápida)
+#define WIFI_IP "192.168.0.106"        // endereço fixo da placa
+#define WIFI_MASCARA "255.255.255.0"   // máscara da rede local
+#define WIFI_GATEWAY "192.168.0.1"     // roteador
+#define WIFI_TIMEOUT_MS 20000          // prazo de cada tentativa de associação
+#define WIFI_BACKOFF_MIN_MS 1000       // espera antes da primeira nova tentativa
+#define WIFI_BACKOFF_MAX_MS 60000      // teto do backoff exponencial
+
+// webserver
+#define HTTP_OCIOSO_POLL 10            // ciclos de 500ms do lwIP sem requisição antes de fechar a conexão (5s)
+
 // definições de pinos
 #define BUTTON_A 5                     // gpio para botão A (alterna cômodos ou desliga LEDs com pressão longa)
 #define BUTTON_B 6                     // GPIO para Botão B (desliga emergência)
@@ -39,6 +61,7 @@
 // variáveis globais
 typedef enum { VERMELHO, VERDE, AZUL, AMARELO, CIANO, LILAS } Cor; // enum para representar cores do LED RGB e matriz
 typedef enum { QUARTO_1, QUARTO_2, COZINHA, BANHEIRO } Comodo;   // enum para representar os 4 cômodos controlados
+_Static_assert(LILAS + 1 == CONTROLE_UDP_CORES && BANHEIRO + 1 == CONTROLE_UDP_COMODOS, "limites do protocolo UDP");
 static Cor cor_atual = VERMELHO;       // cor inicial do LED RGB e matriz (
 static Comodo comodo_atual = QUARTO_1;// cômodo inicial 
 static bool led_ligado = false;        // estado inicial do LED RGB e matriz (desligado)
@@ -50,41 +73,89 @@ static uint32_t ultima_atualizacao_oled = 0; // timestamp da última atualizaç
 static uint32_t ultimo_buzzer = 0;     // timestamp da última alternância do buzzer
 static uint32_t botao_a_pressao_inicio = 0; // timestamp do início da pressão do botão A
 static bool botao_a_pressionado = false; // estado do botão A 
-
-// mapeamento da matriz de LEDS
-static const int pixel_map[5][5] = {   // índices dos LEDs na matriz 
-    {24, 23, 22, 21, 20},            // Linha 1: índices dos LEDs
-    {15, 16, 17, 18, 19},            // Linha 2: índices dos LEDs
-    {14, 13, 12, 11, 10},            // Linha 3: índices dos LEDs
-    {5,  6,  7,  8,  9},             // Linha 4: índices dos LEDs
-    {4,  3,  2,  1,  0}              // Linha 5: índices dos LEDs
-}; 
-
-// LEDs por cômodo (4 LEDs por cômodo, total de 16 LEDs)
-static const int comodos[4][4] = {     // mapeamento dos LEDs para cada cômodo
-    {24, 23, 15, 16},                  // quarto 1: canto superior esquerdo
-    {21, 20, 18, 19},                  // quarto 2: canto superior direito
-    {5, 6, 4, 3},                      // cozinha: canto inferior esquerdo
-    {8, 9, 1, 0}                       // banheiro: canto inferior direito
+static uint32_t ultima_verificacao_memoria = 0; // timestamp da última verificação das marcas d'água
+static mem_size_t lwip_pico_logado = 0; // maior uso do heap do lwIP já logado
+static char relatorio_boot[768];       // WS2812 e tabela de RAM, impressos quando o monitor serial abre a porta USB
+static bool relatorio_boot_pendente = true; // relatório de boot ainda não impresso
+
+// buffers de rede reservados estaticamente: com pico_cyw43_arch_lwip_threadsafe_background os
+// callbacks do lwIP rodam em IRQ, concorrentes com o loop principal, mas serializados entre si;
+// só eles tocam nestes buffers, então um de cada basta e nenhum ocupa a pilha do núcleo 0
+static char http_requisicao[256];      // requisição HTTP recebida
+static char http_pagina[2000];         // página HTML montada
+static uint8_t http_tela[ESPELHO_MAX_SAIDA]; // quadro do OLED comprimido para /api/screen
+static uint8_t udp_datagrama[CONTROLE_UDP_MAX_DATAGRAMA]; // datagrama de controle copiado do pbuf
+
+// estado de cada conexão HTTP, guardado no arg do PCB junto com a entrada do cliente na admissão
+typedef enum { CONEXAO_ADMITIDA = 1, CONEXAO_LIMITADA, CONEXAO_ENCERRADA } EstadoConexao;
+#define CONEXAO_ARG(estado, cliente) ((void *)(uintptr_t)((estado) | (uint32_t)(cliente) << 8))
+#define CONEXAO_ESTADO(arg) ((uintptr_t)(arg) & 0xFF)
+#define CONEXAO_CLIENTE(arg) ((uint8_t)((uintptr_t)(arg) >> 8))
+static const char resposta_429[] =     // resposta fixa para clientes acima da taxa (enviada sem cópia)
+    "HTTP/1.1 429 Too Many Requests\r\n"
+    "Retry-After: 1\r\n"
+    "Content-Length: 0\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+static uint32_t ultimo_relatorio_admissao = 0; // timestamp do último log dos contadores de admissão
+static uint32_t admissao_recusas_logadas = 0; // 429 + RST já logados
+
+// estado da conexão Wi-Fi (avançado por wifi_tarefa no loop principal)
+typedef enum { WIFI_SEM_RADIO, WIFI_AGUARDANDO, WIFI_CONECTANDO, WIFI_CONECTADO } EstadoWifi;
+static EstadoWifi wifi_estado = WIFI_SEM_RADIO; // sem rádio até o cyw43_arch_init
+static uint32_t wifi_prazo = 0;        // fim da tentativa atual ou da espera do backoff
+static uint32_t wifi_backoff_ms = WIFI_BACKOFF_MIN_MS; // próxima espera após falha ou queda
+static bool wifi_endereco_aplicado = false; // IP fixo/lease já aplicado nesta tentativa
+static ip4_addr_t lease_ip, lease_mascara, lease_gateway; // IP fixo ou último lease do DHCP
+static struct tcp_pcb *servidor = NULL; // PCB de escuta na porta 80 (só existe com o enlace ativo)
+static struct udp_pcb *controle = NULL; // PCB do controle UDP (só existe com o enlace ativo)
+
+// geometria das fitas WS2812: a matriz da placa e, opcionalmente, fitas de iluminação dos cômodos
+#define FITAS_COMODOS 0                // 1 = liga as fitas dos cômodos nos GPIOs 8 e 9
+#define MODO_FITAS WS2812_MODO_SM_POR_FITA // ou WS2812_MODO_PARALELO: uma SM para até 8 fitas em pinos adjacentes
+static const ws2812_geometria_t geometria = {
+    .modo = MODO_FITAS,                // uma SM e um canal DMA por fita
+    .num_fitas = 1 + 2 * FITAS_COMODOS, // matriz + fitas dos cômodos
+    .fitas = {
+        {WS2812_PIN, MATRIZ_LEDS},     // fita 0: matriz 5x5 da BitDogLab (GPIO 7)
+        {8, 240},                      // fita 1: quartos (GPIO 8, adjacente à matriz)
+        {9, 240},                      // fita 2: cozinha e banheiro (GPIO 9)
+    },
+    .num_trechos = 4 * FITAS_COMODOS,  // trechos de LEDs de cada cômodo
+    .trechos = {
+        {QUARTO_1, 1, 0, 120},         // quarto 1: LEDs 0-119 da fita 1
+        {QUARTO_2, 1, 120, 120},       // quarto 2: LEDs 120-239 da fita 1
+        {COZINHA, 2, 0, 160},          // cozinha: LEDs 0-159 da fita 2
+        {BANHEIRO, 2, 160, 80},        // banheiro: LEDs 160-239 da fita 2
+    },
 };
 
-// LEDs da cruz central (9 LEDs, brancos fixos)
-static const int cruz[] = {22, 17, 12, 7, 2, 14, 13, 11, 10}; // índices dos LEDs que formam uma cruz no centro
-
 // protótipos de funções
 void inicializar_perifericos(void);     // inicializa GPIOs para LED RGB, botões, e buzzer
-float ler_temperatura(void);            // lê temperatura do sensor interno via ADC
+int32_t ler_temperatura(void);          // lê temperatura do sensor interno via ADC, em centésimos de °C
 void configurar_led_rgb(Cor cor, bool estado); // configura LED RGB com cor e estado
 void atualizar_matriz(void);            // atualiza matriz WS2812 com base no cômodo, cor e estado
 static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err); // aceita conexões TCP
 static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err); // processa requisições HTTP
+static void tcp_server_err(void *arg, err_t err); // conexão abortada pelo lwIP
+static err_t tcp_server_poll(void *arg, struct tcp_pcb *tpcb); // fecha conexões ociosas
+static void conexao_liberar_vaga(void *arg); // devolve as vagas (global e do IP) da conexão
+static err_t conexao_encerrar(struct tcp_pcb *tpcb, void *arg); // fecha a conexão e libera a vaga
 void processar_requisicao(char *requisicao, uint16_t len); // interpreta comandos HTTP
+static void servir_tela(struct tcp_pcb *tpcb, const char *requisicao); // responde /api/screen com o framebuffer do OLED
 void atualizar_display(void);           // atualiza display OLED com informações do sistema
+void wifi_iniciar(void);                // liga o rádio e agenda a primeira associação
+void wifi_tarefa(uint32_t agora);       // máquina de estados da conexão Wi-Fi
+static bool servidor_iniciar(void);     // abre o servidor TCP na porta 80
+static void servidor_parar(void);       // fecha o servidor TCP
+static bool controle_iniciar(void);     // abre a porta do controle UDP
+static void controle_parar(void);       // fecha a porta do controle UDP
+static void controle_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t porta); // aplica comandos UDP
 
 // função principal
 int main() {
+    memoria_pintar_pilhas();            // marca a parte livre das pilhas antes de qualquer uso
     stdio_init_all();                   // inicializa UART para logs no Serial Monitor
-    sleep_ms(2000);                     // aguarda 2 segundos para estabilizar a inicialização
 
     // inicializa periféricos e sensores
     inicializar_perifericos();          // configura GPIOs para LED RGB, botões, e buzzer
@@ -97,51 +168,56 @@ int main() {
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // define pino SCL como função I2C
     gpio_pull_up(I2C_SDA);              // habilita pull-up interno para SDA
     gpio_pull_up(I2C_SCL);              // habilita pull-up interno para SCL
-    sleep_ms(500);                      // aguarda 500ms para estabilizar I2C
-    ssd1306_init(&disp, WIDTH, HEIGHT, false, OLED_ADDRESS, I2C_PORT); // inicializa estrutura do OLED
+    if (!ssd1306_init(&disp, WIDTH, HEIGHT, false, OLED_ADDRESS, I2C_PORT)) { // associa o framebuffer estático ao OLED
+        printf("Falha na configuração do OLED\n"); // loga erro
+        return -1;                      // encerra programa em caso de falha
+    }
     ssd1306_config(&disp);              // configura parâmetros do display OLED
     ssd1306_fill(&disp, 0);             // limpa o buffer do display
     ssd1306_send_data(&disp);           // envia buffer inicial ao OLED
 
-    // inicializa WS2812
-    PIO pio = pio0;                     // usa PIO0 para controlar a matriz WS2812
-    uint offset = pio_add_program(pio, &ws2812_program); // carrega programa PIO para WS2812
-    ws2812_program_init(pio, 0, offset, WS2812_PIN, 800000, false); // inicializa WS2812 
-
-    // inicializa Wi-Fi
-    if (cyw43_arch_init()) {            // inicializa módulo Wi-Fi CYW43439
-        printf("Falha na inicialização do Wi-Fi\n"); // loga erro no Serial Monitor
-        return -1;                      // encerra programa em caso de falha
-    }
-    cyw43_arch_enable_sta_mode();       // ativa modo estação (cliente Wi-Fi)
-    printf("Conectando ao Wi-Fi...\n"); // loga tentativa de conexão
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, 20000)) { // tenta conectar com timeout de 20s
-        printf("Falha na conexão Wi-Fi\n"); // loga erro se a conexão falhar
+    // inicializa WS2812 (matriz e fitas dos cômodos)
+    if (!ws2812_multi_init(&geometria, pio0)) { // reserva SMs e canais DMA no PIO0
+        printf("Falha na configuração das fitas WS2812\n"); // loga erro
         return -1;                      // encerra programa em caso de falha
     }
-    printf("Conectado ao Wi-Fi\n");     // confirma conexão bem-sucedida
-    if (netif_default) {                // verifica se a interface de rede está ativa
-        printf("IP: %s\n", ipaddr_ntoa(&netif_default->ip_addr)); // exibe endereço IP no Serial Monitor
-    }
-
-    // configura servidor TCP
-    struct tcp_pcb *server = tcp_new(); // cria um novo PCB (Protocol Control Block) para o webserver
-    if (!server) {                      // verifica se a criação do PCB falhou
-        printf("Falha na criação do servidor TCP\n"); // loga erro
-        return -1;                      // encerra programa em caso de falha
-    }
-    if (tcp_bind(server, IP_ADDR_ANY, 80) != ERR_OK) { // associa o servidor à porta 80 (HTTP)
-        printf("Falha no bind TCP\n");  // loga erro se o bind falhar
-        return -1;                      // encerra programa em caso de falha
-    }
-    server = tcp_listen(server);        // coloca o servidor em modo escuta
-    tcp_accept(server, tcp_server_accept); // define callback para aceitar conexões
-    printf("Servidor escutando na porta 80\n\n"); // loga que o servidor está ativo
+    uint32_t quadro_us = ws2812_multi_tempo_quadro_us(&geometria); // modelo do tempo de quadro
+    int relatorio_len = snprintf(relatorio_boot, sizeof(relatorio_boot), // taxa de atualização possível
+                                 "WS2812: %u fita(s), quadro de %lu us (até %lu quadros/s)\n", geometria.num_fitas,
+                                 (unsigned long)quadro_us, (unsigned long)(1000000 / quadro_us));
+
+    // orçamento de RAM: buffers estáticos por subsistema, heap e pools do lwIP, pilhas
+    memoria_registrar("OLED (quadro + glifos)", ssd1306_ram_bytes());
+    memoria_registrar("espelho do OLED", ssd1306_espelho_memoria() + sizeof(http_tela));
+    memoria_registrar("WS2812 (pixels + planos)", ws2812_multi_memoria());
+    memoria_registrar("HTTP (requisicao + pagina)", sizeof(http_requisicao) + sizeof(http_pagina));
+    memoria_registrar("controle UDP", controle_udp_memoria() + sizeof(udp_datagrama));
+    memoria_registrar("admissao HTTP", admissao_memoria());
+    memoria_registrar("relatorio de boot", sizeof(relatorio_boot));
+    memoria_registrar("lwIP heap (MEM_SIZE)", MEM_SIZE);
+    memoria_registrar("lwIP pbufs (PBUF_POOL)", PBUF_POOL_SIZE * PBUF_POOL_BUFSIZE);
+    memoria_resumo(relatorio_boot + relatorio_len, sizeof(relatorio_boot) - relatorio_len); // tabela após a linha do WS2812
+
+    // inicializa Wi-Fi sem bloquear: a associação avança em wifi_tarefa
+    wifi_iniciar();                     // liga o rádio e agenda a primeira tentativa
+    uint32_t inicio = to_ms_since_boot(get_absolute_time()); // instante do fim da inicialização
+    ultima_leitura_temperatura = inicio - 1000; // força leitura de temperatura na primeira volta do loop
+    ultima_atualizacao_oled = inicio - 1000; // força atualização do OLED na primeira volta do loop
 
     // loop principal
     while (true) {
-        cyw43_arch_poll();              // processa eventos de rede (lwIP) para manter o webserver ativo
+        if (wifi_estado != WIFI_SEM_RADIO) {
+            cyw43_arch_poll();          // processa eventos de rede (lwIP) para manter o webserver ativo
+        }
         uint32_t agora = to_ms_since_boot(get_absolute_time()); // obtém tempo atual em milissegundos
+        wifi_tarefa(agora);             // associa, reassocia com backoff e liga/desliga o servidor
+
+        // o stdio sai só pela USB: o relatório de boot espera o host abrir a porta CDC, sem
+        // atrasar a interface e o alarme quando não há monitor serial
+        if (relatorio_boot_pendente && stdio_usb_connected()) {
+            printf("%s", relatorio_boot);   // imprime WS2812 e tabela de RAM no Serial Monitor
+            relatorio_boot_pendente = false;
+        }
 
         // verifica botões a cada 10ms
         if (agora - ultimo_botao >= 10) { // verifica botões a cada 10ms para responsividade
@@ -205,8 +281,11 @@ int main() {
 
         // lê temperatura a cada 1000ms
         if (agora - ultima_leitura_temperatura >= 1000) { // verifica temperatura a cada 1s
-            float temperatura = ler_temperatura(); // lê temperatura do sensor interno
-            if (temperatura > 40.0f) {         // se temperatura exceder 40°C
+            int32_t temperatura = ler_temperatura(); // lê temperatura do sensor interno
+            if (temperatura > TEMPERATURA_LIMITE_CENTI && !emergencia) { // se temperatura exceder 40°C
+                char texto[TEMPERATURA_MAX_TEXTO]; // temperatura com uma casa decimal
+                temperatura_formatar(temperatura, texto);
+                printf("Temperatura %sC: emergência ativada\n\n", texto); // loga o disparo do alarme
                 emergencia = true;             // ativa modo de emergência
             }
             ultima_leitura_temperatura = agora; // atualiza timestamp da leitura
@@ -234,6 +313,34 @@ int main() {
         }
         atualizar_matriz();                     // atualiza matriz WS2812 (cômodo + cruz)
 
+        // marcas d'água das pilhas e do heap do lwIP a cada 10s
+        if (agora - ultima_verificacao_memoria >= 10000) { // loga só quando algum pico aumenta
+            memoria_verificar();               // pilhas dos dois núcleos
+            cyw43_arch_lwip_begin();           // estatísticas alteradas pelo lwIP em IRQ
+            mem_size_t lwip_pico = lwip_stats.mem.max;
+            unsigned lwip_falhas = lwip_stats.mem.err;
+            cyw43_arch_lwip_end();
+            if (lwip_pico > lwip_pico_logado) { // heap do lwIP (MEM_SIZE)
+                lwip_pico_logado = lwip_pico;
+                printf("Heap do lwIP: pico de %u de %u bytes (%u falhas)\n\n", (unsigned)lwip_pico_logado,
+                       (unsigned)MEM_SIZE, lwip_falhas);
+            }
+            ultima_verificacao_memoria = agora; // atualiza timestamp da verificação
+        }
+
+        // carga recusada pelo webserver, a cada 10s quando houver recusas novas
+        if (agora - ultimo_relatorio_admissao >= 10000) {
+            cyw43_arch_lwip_begin();           // contadores alterados nos callbacks do lwIP
+            admissao_contadores_t c = *admissao_contadores();
+            cyw43_arch_lwip_end();
+            if (c.limitadas + c.lotadas != admissao_recusas_logadas) { // houve 429 ou RST desde o último log
+                admissao_recusas_logadas = c.limitadas + c.lotadas;
+                printf("Webserver: %lu aceitas, %lu limitadas (429), %lu recusadas (RST), pico de %u conexões\n\n",
+                       (unsigned long)c.aceitas, (unsigned long)c.limitadas, (unsigned long)c.lotadas, c.pico_em_voo);
+            }
+            ultimo_relatorio_admissao = agora; // atualiza timestamp do relatório
+        }
+
         sleep_ms(10);                          // delay de 10ms para evitar sobrecarga do loop
     }
 
@@ -241,6 +348,136 @@ int main() {
     return 0;                                  // retorno padrão 
 }
 
+// liga o rádio; sem ele o painel segue apenas com os controles locais
+void wifi_iniciar(void) {
+    if (cyw43_arch_init()) {                   // inicializa módulo Wi-Fi CYW43439
+        printf("Falha na inicialização do Wi-Fi: painel apenas local\n"); // loga erro
+        return;                                // wifi_estado permanece WIFI_SEM_RADIO
+    }
+    cyw43_arch_enable_sta_mode();              // ativa modo estação (cliente Wi-Fi)
+#if WIFI_IP_FIXO
+    ip4addr_aton(WIFI_IP, &lease_ip);          // endereço fixo usado em toda associação
+    ip4addr_aton(WIFI_MASCARA, &lease_mascara);
+    ip4addr_aton(WIFI_GATEWAY, &lease_gateway);
+#endif
+    wifi_estado = WIFI_AGUARDANDO;             // primeira tentativa na próxima chamada de wifi_tarefa
+    wifi_prazo = to_ms_since_boot(get_absolute_time());
+}
+
+// agenda nova tentativa com backoff exponencial
+static void wifi_reagendar(uint32_t agora, const char *motivo) {
+    cyw43_arch_lwip_begin();
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA); // encerra a associação em curso: a próxima parte do zero
+    cyw43_arch_lwip_end();
+    printf("Wi-Fi: %s, nova tentativa em %lu ms\n\n", motivo, (unsigned long)wifi_backoff_ms); // loga motivo e espera
+    wifi_estado = WIFI_AGUARDANDO;             // aguarda o fim do backoff
+    wifi_prazo = agora + wifi_backoff_ms;      // instante da próxima tentativa
+    wifi_backoff_ms = wifi_backoff_ms * 2 > WIFI_BACKOFF_MAX_MS ? WIFI_BACKOFF_MAX_MS : wifi_backoff_ms * 2; // dobra até o teto
+}
+
+// máquina de estados da conexão: nunca bloqueia o loop principal
+void wifi_tarefa(uint32_t agora) {
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA]; // interface da estação
+    int status;
+
+    switch (wifi_estado) {
+    case WIFI_SEM_RADIO:                       // rádio não inicializou: nada a fazer
+        break;
+
+    case WIFI_AGUARDANDO:                      // espera o backoff e inicia a associação
+        if ((int32_t)(agora - wifi_prazo) < 0) break;
+        printf("Conectando ao Wi-Fi...\n");    // loga tentativa de conexão
+        if (cyw43_arch_wifi_connect_async(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK)) { // dispara associação sem esperar
+            wifi_reagendar(agora, "falha ao iniciar associação");
+            break;
+        }
+        wifi_estado = WIFI_CONECTANDO;         // acompanha a associação nas próximas voltas
+        wifi_prazo = agora + WIFI_TIMEOUT_MS;  // prazo desta tentativa
+        wifi_endereco_aplicado = false;        // IP fixo/lease ainda não aplicado
+        break;
+
+    case WIFI_CONECTANDO:                      // associação em andamento
+        status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+        if (status == CYW43_LINK_UP) {         // associado e com IP
+            lease_ip = *netif_ip4_addr(netif); // guarda o lease para a próxima reassociação
+            lease_mascara = *netif_ip4_netmask(netif);
+            lease_gateway = *netif_ip4_gw(netif);
+            printf("Conectado ao Wi-Fi\nIP: %s\n", ip4addr_ntoa(&lease_ip)); // confirma conexão e exibe IP
+            cyw43_arch_lwip_begin();
+            bool ok = servidor_iniciar() && controle_iniciar(); // webserver e controle UDP só existem com o enlace ativo
+            cyw43_arch_lwip_end();
+            if (!ok) {
+                cyw43_arch_lwip_begin();
+                servidor_parar();              // libera o que chegou a abrir
+                controle_parar();
+                cyw43_arch_lwip_end();
+                wifi_reagendar(agora, "servidores indisponíveis");
+                break;
+            }
+            wifi_estado = WIFI_CONECTADO;
+            wifi_backoff_ms = WIFI_BACKOFF_MIN_MS; // conexão estável: backoff volta ao mínimo
+        } else if (status == CYW43_LINK_NOIP && !wifi_endereco_aplicado && !ip4_addr_isany_val(lease_ip)) {
+            // associado sem IP: aplica o IP fixo ou o último lease sem esperar o DHCP
+            // (com DHCP ativo, o servidor ainda confirma ou troca o endereço em segundo plano)
+            cyw43_arch_lwip_begin();
+#if WIFI_IP_FIXO
+            dhcp_stop(netif);                  // IP fixo: DHCP desnecessário
+#endif
+            netif_set_addr(netif, &lease_ip, &lease_mascara, &lease_gateway);
+            cyw43_arch_lwip_end();
+            wifi_endereco_aplicado = true;
+        } else if (status < 0 || (int32_t)(agora - wifi_prazo) >= 0) { // falha ou prazo esgotado
+            wifi_reagendar(agora, status == CYW43_LINK_BADAUTH ? "senha recusada" :
+                                  status == CYW43_LINK_NONET ? "rede não encontrada" :
+                                  status < 0 ? "falha na associação" : "tempo esgotado");
+        }
+        break;
+
+    case WIFI_CONECTADO:                       // vigia o enlace
+        status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+        if (status != CYW43_LINK_UP) {         // roteador caiu ou sinal perdido
+            cyw43_arch_lwip_begin();
+            servidor_parar();                  // fecha a escuta até o enlace voltar
+            controle_parar();
+            cyw43_arch_lwip_end();
+            wifi_reagendar(agora, "enlace perdido");
+        }
+        break;
+    }
+}
+
+// configura servidor TCP
+static bool servidor_iniciar(void) {
+    struct tcp_pcb *pcb = tcp_new();           // cria um novo PCB (Protocol Control Block) para o webserver
+    if (!pcb) {                                // verifica se a criação do PCB falhou
+        printf("Falha na criação do servidor TCP\n"); // loga erro
+        return false;
+    }
+    if (tcp_bind(pcb, IP_ADDR_ANY, 80) != ERR_OK) { // associa o servidor à porta 80 (HTTP)
+        printf("Falha no bind TCP\n");         // loga erro se o bind falhar
+        tcp_close(pcb);                        // libera o PCB
+        return false;
+    }
+    servidor = tcp_listen(pcb);                // coloca o servidor em modo escuta
+    if (!servidor) {                           // sem memória para o PCB de escuta
+        printf("Falha no listen TCP\n");       // loga erro
+        tcp_close(pcb);                        // libera o PCB original
+        return false;
+    }
+    tcp_accept(servidor, tcp_server_accept);   // define callback para aceitar conexões
+    printf("Servidor escutando na porta 80\n\n"); // loga que o servidor está ativo
+    return true;
+}
+
+// fecha o servidor TCP quando o enlace cai
+static void servidor_parar(void) {
+    if (servidor) {
+        tcp_close(servidor);                   // libera o PCB de escuta
+        servidor = NULL;
+        printf("Servidor na porta 80 desligado\n"); // loga parada
+    }
+}
+
 // inicializa periféricos
 void inicializar_perifericos(void) {
     gpio_init(LED_R);                          // inicializa GPIO do LED vermelho
@@ -267,70 +504,130 @@ void inicializar_perifericos(void) {
 }
 
 // lê temperatura do sensor interno
-float ler_temperatura(void) {
+int32_t ler_temperatura(void) {
     adc_select_input(4);                       // seleciona canal 4 do ADC
     uint16_t valor_bruto = adc_read();         // lê valor bruto (12 bits, 0-4095)
-    const float fator_conversao = 3.3f / (1 << 12); // fator para converter ADC para tensão (Vref = 3.3V)
-    float temperatura = 27.0f - ((valor_bruto * fator_conversao) - 0.706f) / 0.001721f; // converte para °C (equação do RP2040)
-    return temperatura;                        // retorna temperatura em °C
+    return temperatura_centi(valor_bruto);     // converte para centésimos de °C (equação do RP2040, sem float)
 }
 
 // configura LED RGB
 void configurar_led_rgb(Cor cor, bool estado) {
-    uint8_t r = 0, g = 0, b = 0;              // inicializa componentes RGB como 0
-    if (estado) {                              // se LED deve estar ligado
-        switch (cor) {                         // define valores RGB com base na cor
-            case VERMELHO: r = 32; break;     // vermelho
-            case VERDE: g = 32; break;         // verde
-            case AZUL: b = 32; break;          // azul
-            case AMARELO: r = 32; g = 32; break; // amarelo
-            case CIANO: g = 32; b = 32; break; // ciano
-            case LILAS: r = 32; b = 32; break; // lilás
-        }
-    }
-    gpio_put(LED_R, r > 0);                    // liga/desliga vermelho
-    gpio_put(LED_G, g > 0);                    // liga/desliga verde
-    gpio_put(LED_B, b > 0);                    // liga/desliga azul
+    uint32_t grb = estado ? cor_grb[cor] : 0; // consulta a tabela de cores (0 = apagado)
+    gpio_put(LED_R, (grb >> 8) & 0xFF);       // liga/desliga vermelho
+    gpio_put(LED_G, (grb >> 16) & 0xFF);      // liga/desliga verde
+    gpio_put(LED_B, grb & 0xFF);              // liga/desliga azul
 }
 
 // atualiza matriz de LEDs WS2812
 void atualizar_matriz(void) {
-    uint32_t pixels[25] = {0};                 // inicializa array de 25 LEDs como apagados
-    // configura cruz branca (RGB 10, 10, 10)
-    for (int i = 0; i < 9; i++) {             // itera pelos 9 LEDs da cruz
-        pixels[cruz[i]] = ((uint32_t)(10) << 8) | ((uint32_t)(10) << 16) | (uint32_t)(10); // define cor branca
-    }
-    // configura LEDs do cômodo atual
-    if (emergencia) {                          // se emergência ativa
-        for (int i = 0; i < 4; i++) {         // itera pelos 4 LEDs do cômodo
-            pixels[comodos[comodo_atual][i]] = ((uint32_t)(32) << 8) | ((uint32_t)(0) << 16) | (uint32_t)(0); // define cor vermelha
-        }
-    } else if (led_ligado) {                   // se LEDs ligados e sem emergência
-        uint8_t r = 0, g = 0, b = 0;          // inicializa componentes RGB
-        switch (cor_atual) {                   // define valores RGB com base na cor atual
-            case VERMELHO: r = 32; break;     // vermelho
-            case VERDE: g = 32; break;         // verde
-            case AZUL: b = 32; break;          // azul
-            case AMARELO: r = 32; g = 32; break; // amarelo
-            case CIANO: g = 32; b = 32; break; // ciano
-            case LILAS: r = 32; b = 32; break; // lilás
-        }
-        for (int i = 0; i < 4; i++) {         // itera pelos 4 LEDs do cômodo
-            pixels[comodos[comodo_atual][i]] = ((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b); // define cor
-        }
+    ws2812_multi_aguardar();                   // espera o DMA liberar os buffers do quadro anterior
+    const uint32_t *quadro = quadros_base[comodo_atual][cor_atual][led_ligado][emergencia]; // quadro pré-calculado (cruz + cômodo)
+    uint32_t *matriz = ws2812_multi_fita(0);   // buffer da matriz no formato da FIFO
+    for (int i = 0; i < MATRIZ_LEDS; i++) {    // itera pelos 25 LEDs
+        matriz[i] = quadro[i] << 8u;           // GRB alinhado aos bits mais significativos
     }
-    // envia dados para a matriz WS2812
-    for (int i = 0; i < 25; i++) {            // itera pelos 25 LEDs
-        pio_sm_put_blocking(pio0, 0, pixels[i] << 8u); // envia valor RGB para WS2812 via PIO
+    uint32_t cor_comodo = emergencia ? GRB_EMERGENCIA : led_ligado ? cor_grb[cor_atual] : 0; // mesma regra da matriz
+    for (int c = 0; c < NUM_COMODOS; c++) {    // fitas dos cômodos: só o cômodo atual aceso
+        ws2812_multi_pintar_comodo(c, c == comodo_atual ? cor_comodo : 0);
     }
+    ws2812_multi_mostrar();                    // dispara o DMA e retorna sem esperar a transmissão
 }
 
 // callback de aceitação de conexão TCP
 static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
+    uint8_t cliente;                           // entrada do IP na admissão, devolvida ao fechar
+    admissao_t admissao = admissao_verificar(ip_addr_get_ip4_u32(&newpcb->remote_ip), // taxa do IP e limites de conexões
+                                             to_ms_since_boot(get_absolute_time()), &cliente);
+    if (admissao == ADMISSAO_LOTADA) {         // conexões demais abertas: RST antes de qualquer processamento
+        tcp_abort(newpcb);                     // libera o PCB
+        return ERR_ABRT;                       // o lwIP não deve mais usar newpcb
+    }
+    tcp_arg(newpcb, CONEXAO_ARG(admissao == ADMISSAO_ACEITA ? CONEXAO_ADMITIDA : CONEXAO_LIMITADA, cliente));
     tcp_recv(newpcb, tcp_server_recv);         // define callback para processar requisições recebidas
+    tcp_err(newpcb, tcp_server_err);           // libera a vaga se o lwIP abortar a conexão
+    tcp_poll(newpcb, tcp_server_poll, HTTP_OCIOSO_POLL); // fecha clientes que conectam e não enviam nada
     return ERR_OK;                             // aceita conexão
 }
 
+// devolve as vagas (global e do IP) ocupadas pela conexão, admitida ou à espera do 429
+static void conexao_liberar_vaga(void *arg) {
+    if (CONEXAO_ESTADO(arg) == CONEXAO_ADMITIDA || CONEXAO_ESTADO(arg) == CONEXAO_LIMITADA) {
+        admissao_encerrar(CONEXAO_CLIENTE(arg));
+    }
+}
+
+// fecha a conexão e devolve a vaga do limite global (uma vez por conexão)
+static err_t conexao_encerrar(struct tcp_pcb *tpcb, void *arg) {
+    conexao_liberar_vaga(arg);                 // libera a vaga de conexão em voo
+    tcp_arg(tpcb, CONEXAO_ARG(CONEXAO_ENCERRADA, 0));
+    tcp_recv(tpcb, NULL);                      // remove callbacks
+    tcp_err(tpcb, NULL);
+    tcp_poll(tpcb, NULL, 0);
+    if (tcp_close(tpcb) != ERR_OK) {           // sem memória para o FIN
+        tcp_abort(tpcb);                       // descarta a conexão com RST
+        return ERR_ABRT;
+    }
+    return ERR_OK;
+}
+
+// o lwIP abortou a conexão (RST do cliente, falta de memória); o PCB já foi liberado
+static void tcp_server_err(void *arg, err_t err) {
+    conexao_liberar_vaga(arg);                 // libera a vaga de conexão em voo
+}
+
+// cliente conectado sem enviar a requisição dentro do prazo
+static err_t tcp_server_poll(void *arg, struct tcp_pcb *tpcb) {
+    return conexao_encerrar(tpcb, arg);        // fecha e libera a vaga
+}
+
+// abre a porta do controle UDP
+static bool controle_iniciar(void) {
+    controle = udp_new();                      // cria PCB UDP
+    if (!controle) {
+        printf("Falha na criação do PCB UDP\n"); // loga erro
+        return false;
+    }
+    if (udp_bind(controle, IP_ADDR_ANY, CONTROLE_UDP_PORTA) != ERR_OK) { // associa à porta de controle
+        printf("Falha no bind UDP\n");         // loga erro
+        udp_remove(controle);
+        controle = NULL;
+        return false;
+    }
+    udp_recv(controle, controle_recv, NULL);   // define callback dos datagramas
+    printf("Controle UDP na porta %d\n\n", CONTROLE_UDP_PORTA); // loga que o controle está ativo
+    return true;
+}
+
+// fecha a porta do controle UDP quando o enlace cai
+static void controle_parar(void) {
+    if (controle) {
+        udp_remove(controle);                  // libera o PCB
+        controle = NULL;
+    }
+}
+
+// aplica um datagrama de comandos e responde com o ack (ver lib/controle_udp.h)
+static void controle_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t porta) {
+    uint8_t ack[CONTROLE_UDP_ACK_BYTES];       // resposta
+    uint16_t tamanho = p->tot_len <= sizeof(udp_datagrama) ? pbuf_copy_partial(p, udp_datagrama, sizeof(udp_datagrama), 0) : 0; // maiores que o limite são ignorados
+    pbuf_free(p);                              // libera o buffer recebido
+
+    controle_estado_t estado = {comodo_atual, cor_atual, led_ligado, emergencia}; // estado atual do painel
+    uint16_t n = controle_udp_processar(udp_datagrama, tamanho, ip_addr_get_ip4_u32(addr), porta,
+                                        to_ms_since_boot(get_absolute_time()), &estado, ack);
+    if (!n) return;                            // não é um datagrama de comandos
+    comodo_atual = estado.comodo;              // aplica o novo estado
+    cor_atual = estado.cor;
+    led_ligado = estado.ligado;
+    emergencia = estado.emergencia;
+
+    struct pbuf *r = pbuf_alloc(PBUF_TRANSPORT, n, PBUF_RAM); // buffer do ack
+    if (!r) return;                            // sem memória: o cliente retransmite
+    memcpy(r->payload, ack, n);
+    udp_sendto(pcb, r, addr, porta);           // responde para a origem
+    pbuf_free(r);
+}
+
 // processa requisições HTTP
 void processar_requisicao(char *requisicao, uint16_t len) {
     if (strstr(requisicao, "GET /led_on")) {   // verifica requisição para ligar LED
@@ -369,16 +666,26 @@ void processar_requisicao(char *requisicao, uint16_t len) {
 // callback de recebimento de dados TCP
 static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
     if (!p) {                                  // se não há dados (conexão fechada)
-        tcp_close(tpcb);                       // fecha conexão
-        tcp_recv(tpcb, NULL);                  // remove callback de recebimento
-        return ERR_OK;                         // retorna sucesso
+        return conexao_encerrar(tpcb, arg);    // fecha conexão e libera a vaga
+    }
+    if (CONEXAO_ESTADO(arg) == CONEXAO_LIMITADA) { // cliente acima da taxa: 429 sem ler a requisição
+        pbuf_free(p);                          // descarta a requisição
+        tcp_write(tpcb, resposta_429, sizeof(resposta_429) - 1, 0); // texto constante, sem cópia para o heap
+        tcp_output(tpcb);                      // força envio dos dados
+        return conexao_encerrar(tpcb, arg);    // fecha conexão
     }
 
-    char requisicao[256];                      // buffer estático para evitar fragmentação
-    uint16_t len = p->len < 255 ? p->len : 255; // limita tamanho da requisição a 255 bytes
+    char *requisicao = http_requisicao;        // buffer estático para evitar fragmentação
+    uint16_t len = p->len < sizeof(http_requisicao) - 1 ? p->len : sizeof(http_requisicao) - 1; // limita tamanho da requisição a 255 bytes
     memcpy(requisicao, p->payload, len);       // copia dados da requisição
     requisicao[len] = '\0';                    // adiciona terminador nulo à string
 
+    if (strstr(requisicao, "GET /api/screen")) { // espelho do OLED: resposta binária, sem página HTML
+        servir_tela(tpcb, requisicao);         // envia quadro completo ou delta
+        pbuf_free(p);                          // libera buffer da requisição
+        return conexao_encerrar(tpcb, arg);    // resposta completa: fecha e libera a vaga
+    }
+
     // log de requisições
     if (strstr(requisicao, "GET /led_on")) {   // requisição para ligar LED
         printf("Requisição: led ligado\n\n");  // loga ação no Serial Monitor
@@ -409,10 +716,11 @@ static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
     }
 
     processar_requisicao(requisicao, len);     // processa a requisição para atualizar estados
-    float temperatura = ler_temperatura();     // lê temperatura atual para exibir no HTML
+    char temperatura[TEMPERATURA_MAX_TEXTO];   // temperatura atual para exibir no HTML
+    temperatura_formatar(ler_temperatura(), temperatura); // formata com uma casa decimal
 
-    char html[2000];                           // buffer para página HTML 
-    snprintf(html, sizeof(html),               // formata página HTML com estado atual
+    char *html = http_pagina;                  // buffer estático para a página HTML
+    snprintf(html, sizeof(http_pagina),               // formata página HTML com estado atual
              "HTTP/1.1 200 OK\r\n"            // status HTTP 200
              "Content-Type: text/html\r\n"    // tipo de conteúdo: HTML
              "\r\n"                           // fim do cabeçalho HTTP
@@ -467,7 +775,7 @@ static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
              "<h4>Status</h4>"               // subtítulo da seção
              "<p>LED: %s</p>"                // exibe estado do LED (LIGADO/DESLIGADO)
              "<p>Cor: %s</p>"                // exibe cor atual
-             "<p>Temperatura: %.1fC</p>"     // exibe temperatura
+             "<p>Temperatura: %sC</p>"       // exibe temperatura
              "<p>Emergência: %s</p>"         // exibe estado da emergência (LIGADA/DESLIGADA)
              "</div>"                         // fim da seção de status
              "</body>"                        // fim do corpo
@@ -484,23 +792,55 @@ static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
     tcp_write(tpcb, html, strlen(html), TCP_WRITE_FLAG_COPY); // envia página HTML ao cliente
     tcp_output(tpcb);                         // força envio dos dados
     pbuf_free(p);                             // libera buffer da requisição
-    return ERR_OK;                            // retorna sucesso
+    return conexao_encerrar(tpcb, arg);       // página sem Content-Length: o fim da conexão marca o fim dela
+}
+
+// responde /api/screen?v=<versão> com o framebuffer do OLED em RLE (completo ou XOR contra a versão do cliente)
+static void servir_tela(struct tcp_pcb *tpcb, const char *requisicao) {
+    char cabecalho[200];                      // cabeçalho HTTP da resposta
+    const char *v = strstr(requisicao, "?v="); // versão que o cliente já possui (0 ou ausente = nenhuma)
+    uint32_t versao_cliente = v ? strtoul(v + 3, NULL, 10) : 0;
+    espelho_quadro_t info;                    // versão, base e tamanho do quadro codificado
+    ssd1306_espelho_codificar(&disp, versao_cliente, http_tela, sizeof(http_tela), &info); // comprime o quadro atual
+    int n = snprintf(cabecalho, sizeof(cabecalho), // formata cabeçalho com os metadados do quadro
+                     "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: application/octet-stream\r\n"
+                     "Cache-Control: no-store\r\n"
+                     "X-Screen-Version: %lu\r\n"  // versão a enviar em ?v= na próxima consulta
+                     "X-Screen-Base: %lu\r\n"     // 0 = quadro completo, senão XOR contra esta versão
+                     "Content-Length: %u\r\n"
+                     "\r\n",
+                     (unsigned long)info.versao, (unsigned long)info.base, info.tamanho);
+    tcp_write(tpcb, cabecalho, n, TCP_WRITE_FLAG_COPY); // envia cabeçalho
+    if (info.tamanho) {                       // delta vazio: a tela não mudou
+        tcp_write(tpcb, http_tela, info.tamanho, TCP_WRITE_FLAG_COPY); // envia quadro comprimido
+    }
+    tcp_output(tpcb);                         // força envio dos dados
 }
 
 // atualiza display OLED
 void atualizar_display(void) {
     char temp_str[20];                        // buffer para string do cômodo/temperatura
     char ip_str[16];                          // buffer para string do endereço IP
+    cyw43_arch_lwip_begin();                  // impede /api/screen de ler um quadro pela metade
     ssd1306_fill(&disp, 0);                   // limpa o buffer do display
     snprintf(temp_str, sizeof(temp_str), "%s", // formata nome do cômodo atual
              comodo_atual == QUARTO_1 ? "QUARTO 1" :
              comodo_atual == QUARTO_2 ? "QUARTO 2" :
              comodo_atual == COZINHA ? "COZINHA" : "BANHEIRO");
-    ssd1306_draw_string(&disp, temp_str, 20, 2); // exibe cômodo na linha 1
-    snprintf(temp_str, sizeof(temp_str), "TEMP: %.1fC", ler_temperatura()); // formata temperatura
-    ssd1306_draw_string(&disp, temp_str, 20, 18); // exibe temperatura na linha 2
-    ssd1306_draw_string(&disp, emergencia ? "EMERGENCIA: ON" : "EMERGENCIA: OFF", 2, 34); // exibe estado da emergência na linha 3
-    snprintf(ip_str, sizeof(ip_str), "%s", netif_default ? ipaddr_ntoa(&netif_default->ip_addr) : "N/A"); // formata endereço IP
-    ssd1306_draw_string(&disp, ip_str, 6, 50); // exibe IP na linha 4
+    ssd1306_draw_string(&disp, temp_str, 20, 0); // exibe cômodo na linha 1
+    temperatura_formatar(ler_temperatura(), temp_str); // formata temperatura sem printf de float
+    uint8_t largura = ssd1306_string_width(&ssd1306_font_12x16_digitos, 1, temp_str) + // dígitos grandes
+                      ssd1306_string_width(&ssd1306_font_8x8_prop, 1, "C"); // mais a unidade
+    uint8_t x = ssd1306_draw_string_font(&disp, &ssd1306_font_12x16_digitos, 1, temp_str, // temperatura em dígitos 12x16 centralizados
+                                         largura < WIDTH ? (WIDTH - largura) / 2 : 0, 14);
+    ssd1306_draw_string_font(&disp, &ssd1306_font_8x8_prop, 1, "C", x, 15); // unidade pequena, alinhada ao topo dos dígitos
+    ssd1306_draw_string(&disp, emergencia ? "EMERGENCIA: ON" : "EMERGENCIA: OFF", 2, 38); // exibe estado da emergência
+    snprintf(ip_str, sizeof(ip_str), "%s", // endereço IP ou estado da conexão
+             wifi_estado == WIFI_CONECTADO ? ipaddr_ntoa(&netif_default->ip_addr) :
+             wifi_estado == WIFI_CONECTANDO ? "CONECTANDO..." :
+             wifi_estado == WIFI_AGUARDANDO ? "WI-FI OFFLINE" : "SEM WI-FI");
+    ssd1306_draw_string(&disp, ip_str, 6, 54); // exibe IP na última linha
+    cyw43_arch_lwip_end();                    // libera os callbacks de rede
     ssd1306_send_data(&disp);                 // envia buffer ao display OLED
 }